@@ -2,11 +2,12 @@
 #ifndef __ARCHINOTEADMIN_HPP__
 #define __ARCHINOTEADMIN_HPP__
 
-#include "../ArchiNoteManager/IArchiNoteManager.hpp"
+#include "IArchiNoteManager.hpp"
 #include "../ArchiNoteAttributeRepoAgent/IAttributeRepoAgent.hpp"
 #include "../ArchiNoteStorage/IStorageAdapter.hpp"
-
-class ProjectBriefArchiNoteManager;
+#include "../ArchiNoteConcurrency/WorkStealingExecutor.hpp"
+#include "../ArchiNoteVersioning/ContentBlobStore.hpp"
+#include "../ArchiNoteManager/ProjectBriefManager/ProjectBriefArchiNoteManager.hpp"
 
 
 // ArchiNoteAdmin for managing ArchiNoteManagers and cross-document relations
@@ -14,19 +15,21 @@ class ArchiNoteAdmin {
 private:
     std::map<ArchiNoteType, IArchiNoteManager*> managers;
     IStorageAdapter* storageAdapter = nullptr;
+    // Runs the *Async operations of every manager (each Repo Agent keeps its own order on it)
+    WorkStealingExecutor* executor = new WorkStealingExecutor();
 
     // Helper: Validate cross-document relation
     bool validateCrossDocumentRelation(ArchiNoteType sourceNoteType, const std::string& sourceId, 
                                       ArchiNoteAttributeType sourceType,
                                       ArchiNoteType targetNoteType, const std::string& targetId, 
-                                      ArchiNoteAttributeType targetType) {
+                                      ArchiNoteAttributeType targetType) const {
         auto sourceManager = managers.find(sourceNoteType);
         auto targetManager = managers.find(targetNoteType);
         if (sourceManager == managers.end() || targetManager == managers.end()) {
             return false;
         }
-        return sourceManager->second->getRepoAgent(sourceType)->read(sourceId) && 
-               targetManager->second->getRepoAgent(targetType)->read(targetId);
+        return sourceManager->second->containsAttribute(sourceType, sourceId) &&
+               targetManager->second->containsAttribute(targetType, targetId);
     }
 
 public:
@@ -34,14 +37,18 @@ public:
         // Initialize managers for supported ArchiNote types
         managers[ArchiNoteType::PROJECT_BRIEF] = new ProjectBriefArchiNoteManager();
         // Add other managers as needed (e.g., ArchitectureDesignArchiNoteManager)
+        for (auto& pair : managers) {
+            pair.second->setExecutor(executor);
+        }
     }
 
     ~ArchiNoteAdmin() {
         for (auto& pair : managers) {
             delete pair.second;
         }
-        managers.clear();
+        managers.clear();  // Managers drain their agents' queued operations
         delete storageAdapter;
+        delete executor;
     }
 
     // No copy
@@ -50,9 +57,10 @@ public:
 
     // Move constructor/assignment
     ArchiNoteAdmin(ArchiNoteAdmin&& other) noexcept 
-        : managers(std::move(other.managers)), storageAdapter(other.storageAdapter) {
+        : managers(std::move(other.managers)), storageAdapter(other.storageAdapter), executor(other.executor) {
         other.managers.clear();
         other.storageAdapter = nullptr;
+        other.executor = nullptr;
     }
     ArchiNoteAdmin& operator=(ArchiNoteAdmin&& other) noexcept {
         if (this != &other) {
@@ -61,10 +69,13 @@ public:
             }
             managers.clear();
             delete storageAdapter;
+            delete executor;
             managers = std::move(other.managers);
             storageAdapter = other.storageAdapter;
+            executor = other.executor;
             other.managers.clear();
             other.storageAdapter = nullptr;
+            other.executor = nullptr;
         }
         return *this;
     }
@@ -82,6 +93,7 @@ public:
             default:
                 throw std::invalid_argument("Unsupported ArchiNote type");
         }
+        managers[type]->setExecutor(executor);
     }
 
     void destroyManager(ArchiNoteType type) {
@@ -102,7 +114,23 @@ public:
         return it->second;
     }
 
-    // Serialization
+    // Serialization. With snapshots enabled each ArchiNote is exported from a pinned version while
+    // edits continue
+    void enableSnapshots() {
+        for (auto& pair : managers) {
+            pair.second->enableSnapshots();
+        }
+    }
+
+    void disableSnapshots() {
+        for (auto& pair : managers) {
+            pair.second->disableSnapshots();
+        }
+    }
+
+    // Every manager's exportAllToJSON(), one after another. Each manager pins its snapshot-mode
+    // agents only when its turn comes, so this is not one cut across managers: an edit that lands
+    // mid-export shows up in the managers exported after it and not in the earlier ones
     std::string exportAllArchiNotesToJSON() const {
         std::stringstream json;
         json << "{ \"archinotes\": {";
@@ -156,6 +184,11 @@ public:
 
     // Storage management
     void setStorageAdapter(IStorageAdapter* adapter) {
+        // loadAll enumerates the store, so an adapter without scan support cannot back it
+        if (adapter && !adapter->supportsScan()) {
+            throw std::invalid_argument("Storage adapter does not support enumeration (scan), which loadAllArchiNotes requires");
+        }
+        waitForAsync();  // Queued operations still write to the old adapter
         delete storageAdapter;
         storageAdapter = adapter;
         // Propagate to all managers
@@ -164,6 +197,18 @@ public:
         }
     }
 
+    // Async operations: block until everything submitted so far (by any manager) has run.
+    // Must not be called from an async callback
+    void waitForAsync() {
+        for (auto& pair : managers) {
+            pair.second->waitForAsync();
+        }
+    }
+
+    std::size_t asyncThreadCount() const {
+        return executor ? executor->threadCount() : 0;
+    }
+
     void saveAllArchiNotes() {
         if (!storageAdapter) {
             throw std::runtime_error("No storage adapter set");
@@ -171,14 +216,35 @@ public:
         for (auto& pair : managers) {
             pair.second->saveAll();
         }
+        storageAdapter->flush();  // Commit any batched writes
     }
 
+    // One scan for all managers: each record goes to the first manager that owns its type
     void loadAllArchiNotes() {
         if (!storageAdapter) {
             throw std::runtime_error("No storage adapter set");
         }
+        waitForAsync();
+        for (auto& pair : managers) {
+            pair.second->loadHistory();
+        }
+        {
+            RawPtrWrapper<IStorageCursor> cursor = storageAdapter->scan();
+            std::string id;
+            std::string json;
+            while (cursor->next(id, json)) {
+                if (ContentBlobStore::isBlobKey(id)) {
+                    continue;  // Version history, staged by loadHistory()
+                }
+                for (auto& pair : managers) {
+                    if (pair.second->loadRecord(id, json)) {
+                        break;
+                    }
+                }
+            }
+        }
         for (auto& pair : managers) {
-            pair.second->loadAll();
+            pair.second->pruneHistory();
         }
     }
 };
@@ -17,11 +17,12 @@
 
 
 
-#include "../../Enums/ArchiNoteAttributeType.hpp"
-#include "../../Enums/ArchiNoteAttributeRelationType.hpp"
+#include "../Enums/ArchiNoteAttributeType.hpp"
+#include "../Enums/ArchiNoteAttributeRelationType.hpp"
 #include "../ArchiNoteAttributeRepoAgent/IAttributeRepoAgent.hpp"
+#include "../ArchiNoteIndex/CompletionIndex.hpp"
 
-#include "../../Enums/ArchiNoteType.hpp"
+#include "../Enums/ArchiNoteType.hpp"
 
 
 
@@ -39,26 +40,70 @@ public:
 
     // Access to Repo Agents
     virtual IAttributeRepoAgent* getRepoAgent(ArchiNoteAttributeType type) = 0;
+    // Whether an attribute exists; false (never a throw) for unknown types or ids
+    virtual bool containsAttribute(ArchiNoteAttributeType type, const std::string& id) const noexcept = 0;
+
+    // Dense handles, one numbering per attribute type (see IAttributeRepoAgent::handleOf)
+    virtual AttributeHandle attributeHandle(ArchiNoteAttributeType type, const std::string& id) const noexcept = 0;
+    virtual bool containsAttribute(ArchiNoteAttributeType type, AttributeHandle handle) const noexcept = 0;
 
     // Relations management (intra-document)
     virtual void addRelation(const std::string& sourceId, ArchiNoteAttributeType sourceType, 
                             const std::string& targetId, ArchiNoteAttributeType targetType, 
                             ArchiNoteAttributeRelationType relationType) = 0;
+    virtual void addRelation(AttributeHandle source, ArchiNoteAttributeType sourceType,
+                             AttributeHandle target, ArchiNoteAttributeType targetType,
+                             ArchiNoteAttributeRelationType relationType) = 0;
 
     // Serialization
     virtual std::string toJSON(ArchiNoteAttributeType type, const std::string& id) const = 0;
+    virtual std::string toJSON(ArchiNoteAttributeType type, AttributeHandle handle) const = 0;
     virtual std::string toYAML(ArchiNoteAttributeType type, const std::string& id) const = 0;
     virtual std::string exportAllToJSON() const = 0;
+    // Lock-free snapshot reads for export (see IAttributeRepoAgent::enableSnapshots())
+    virtual void enableSnapshots() = 0;
+    virtual void disableSnapshots() = 0;
+    // Columnar snapshot of one attribute type (see IAttributeRepoAgent::columnarSnapshot)
+    virtual std::shared_ptr<const ColumnarSnapshot> columnarSnapshot(ArchiNoteAttributeType type) = 0;
 
     // Async communication for attributes (delegated to Agents)
     virtual void createAsync(ArchiNoteAttributeType type, const std::string& id, 
                             const std::map<std::string, std::string>& params, 
                             std::function<void(const std::string&, bool)> callback) = 0;
+    virtual void updateAsync(ArchiNoteAttributeType type, const std::string& id,
+                             const std::map<std::string, std::string>& params,
+                             std::function<void(const std::string&, bool)> callback) = 0;
+    virtual void removeAsync(ArchiNoteAttributeType type, const std::string& id,
+                             std::function<void(const std::string&, bool)> callback) = 0;
+    virtual void readAsync(ArchiNoteAttributeType type, const std::string& id,
+                           std::function<void(const std::string&, bool, const std::string&)> callback) = 0;
+    // Run the async operations of every agent on this executor (not owned; nullptr runs them inline)
+    virtual void setExecutor(WorkStealingExecutor* executor) = 0;
+    // Block until every queued async operation of this manager has run
+    virtual void waitForAsync() = 0;
+
+    // Bulk create/update of one attribute type (per-item failures, one storage write per batch)
+    virtual BatchResult createBatch(ArchiNoteAttributeType type, const AttributeBatch& items) = 0;
+    virtual BatchResult updateBatch(ArchiNoteAttributeType type, const AttributeBatch& items) = 0;
 
     // Storage management
     virtual void setStorageAdapter(IStorageAdapter* adapter) = 0;
     virtual void saveAll() = 0;
     virtual void loadAll() = 0;
+    // Hydrate one stored record into the owning agent; false if no agent of this manager owns it
+    virtual bool loadRecord(const std::string& id, const std::string& json) = 0;
+    // Version history around a record scan: stage the stored blobs before loadRecord(), then drop
+    // the ones no loaded record referenced (loadAll() does both)
+    virtual void loadHistory() = 0;
+    virtual void pruneHistory() = 0;
+
+    // Full-text search over the text fields of every attribute (ids in indexing order)
+    virtual std::vector<std::string> searchAll(const std::string& query) const = 0;  // Every term must match
+    virtual std::vector<std::string> searchAny(const std::string& query) const = 0;  // Any term may match
+
+    // Autocomplete: top-k ids / titles starting with a prefix
+    virtual std::vector<std::string> completeId(const std::string& prefix, std::size_t k = 10) const = 0;
+    virtual std::vector<TitleCompletion> completeTitle(const std::string& prefix, std::size_t k = 10) const = 0;
 };
 
 
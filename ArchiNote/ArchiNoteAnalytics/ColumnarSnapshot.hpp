@@ -0,0 +1,347 @@
+#ifndef __COLUMNARSNAPSHOT_HPP__
+#define __COLUMNARSNAPSHOT_HPP__
+
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <optional>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+#include <ctime>
+#include <cstdint>
+#include <cstddef>
+
+#include "../ArchiNoteIndex/IdRegistry.hpp"
+#include "../ArchiNoteMemory/StringInterner.hpp"
+#include "SelectionBitmap.hpp"
+#include "PredicateKernels.hpp"
+
+
+
+
+// One attribute as seen by a ColumnarSnapshot (filled by the repo agent)
+struct ColumnarRow {
+    bool present = false;  // False: the handle's attribute was removed
+    std::string id;
+    std::time_t timestamp = 0;
+    InternedString author;
+    std::int32_t priority = 0;  // 0 for types without a priority
+    InternedString status;  // "" for types without a status
+    std::string title;  // The agent's completion title
+    std::string description;  // Main free text; "" for types without one
+};
+
+// Strings of all rows back to back in one blob; row i is blob[offsets[i], offsets[i + 1])
+class StringColumn {
+private:
+    std::vector<std::uint32_t> offsets{0};
+    std::string blob;
+
+    void append(std::string_view text) {
+        if (blob.size() + text.size() > UINT32_MAX) {
+            throw std::length_error("StringColumn: blob exceeds 4 GiB");
+        }
+        blob.append(text.data(), text.size());
+        offsets.push_back(static_cast<std::uint32_t>(blob.size()));
+    }
+
+public:
+    std::size_t size() const { return offsets.size() - 1; }
+
+    std::string_view at(std::size_t row) const {
+        return std::string_view(blob).substr(offsets[row], offsets[row + 1] - offsets[row]);
+    }
+
+    const char* blobData() const { return blob.data(); }
+    const std::uint32_t* offsetData() const { return offsets.data(); }  // size() + 1 entries
+
+    // Copy of `base` resized to `rowCount` rows, with the rows in `changes` (sorted by handle)
+    // replaced by text(row). Unchanged runs are copied with one append and an offset shift each
+    template <typename Text>
+    static StringColumn patched(const StringColumn& base, std::size_t rowCount,
+                                const std::vector<std::pair<AttributeHandle, ColumnarRow>>& changes, Text text) {
+        StringColumn next;
+        next.offsets.reserve(rowCount + 1);
+        next.blob.reserve(base.blob.size());
+        std::size_t row = 0;
+        auto copyUntil = [&](std::size_t end) {
+            std::size_t baseEnd = std::min(end, base.size());
+            if (row < baseEnd) {
+                std::uint32_t from = base.offsets[row];
+                std::uint32_t start = static_cast<std::uint32_t>(next.blob.size());
+                next.blob.append(base.blob, from, base.offsets[baseEnd] - from);
+                for (std::size_t r = row + 1; r <= baseEnd; ++r) {
+                    next.offsets.push_back(base.offsets[r] - from + start);
+                }
+                row = baseEnd;
+            }
+            for (; row < end; ++row) {
+                next.offsets.push_back(static_cast<std::uint32_t>(next.blob.size()));  // New row, no data yet
+            }
+        };
+        for (const auto& change : changes) {
+            if (change.first >= rowCount) {
+                break;
+            }
+            copyUntil(change.first);
+            next.append(text(change.second));
+            row += 1;
+        }
+        copyUntil(rowCount);
+        return next;
+    }
+};
+
+// Dictionary-encoded column: one 32-bit code per row, code -> value in a small dictionary.
+// Code 0 is always the empty string. Codes only grow, so a code keeps its meaning across refreshes
+class DictionaryColumn {
+private:
+    std::vector<std::uint32_t> codes;
+    std::vector<InternedString> values{InternedString()};
+    std::unordered_map<InternedString, std::uint32_t> codeOf{{InternedString(), 0}};
+
+public:
+    void resize(std::size_t rowCount) { codes.resize(rowCount, 0); }
+
+    void set(std::size_t row, InternedString value) {
+        auto it = codeOf.find(value);
+        if (it == codeOf.end()) {
+            it = codeOf.emplace(value, static_cast<std::uint32_t>(values.size())).first;
+            values.push_back(value);
+        }
+        codes[row] = it->second;
+    }
+
+    // Code of `text`, nullopt if no row ever held it
+    std::optional<std::uint32_t> find(std::string_view text) const {
+        std::optional<InternedString> value = InternedString::lookup(text);
+        if (!value) {
+            return std::nullopt;
+        }
+        auto it = codeOf.find(*value);
+        return it != codeOf.end() ? std::optional<std::uint32_t>(it->second) : std::nullopt;
+    }
+
+    const std::uint32_t* data() const { return codes.data(); }
+    const std::string& at(std::size_t row) const { return values[codes[row]]; }
+    const std::vector<InternedString>& dictionary() const { return values; }
+};
+
+// Read-optimised, immutable column store of one agent's attributes
+// Row i belongs to handle i (see IdRegistry), so rows never move and a refresh only rewrites the
+// rows whose attributes changed; rows of removed attributes stay, with present = 0. Numeric
+// columns are plain contiguous arrays, text columns are offset + blob, and low-cardinality text
+// (status, author) is dictionary-encoded. Filters and aggregates are branch-free loops over those
+// arrays. Filters run as PredicateKernels scans (SIMD where the CPU has it) and return
+// SelectionBitmaps over live rows, which combine with & and |; the raw columns are exposed for
+// custom kernels.
+// Built by the repo agent: each row is a consistent view of its attribute, rows refreshed
+// together are not a point-in-time view of the whole agent.
+class ColumnarSnapshot {
+private:
+    std::vector<std::uint8_t> present;
+    std::vector<std::int64_t> timestamps;
+    std::vector<std::int32_t> priorities;
+    DictionaryColumn statuses;
+    DictionaryColumn authors;
+    StringColumn ids;
+    StringColumn titles;
+    StringColumn descriptions;
+    std::size_t liveCount = 0;
+    std::uint64_t versionNumber = 0;
+
+    // Live rows of `matches`, in place
+    SelectionBitmap liveOnly(SelectionBitmap matches) const {
+        matches &= live();
+        return matches;
+    }
+
+    SelectionBitmap matchCode(const DictionaryColumn& column, std::string_view text) const {
+        SelectionBitmap rows(present.size());
+        std::optional<std::uint32_t> code = column.find(text);
+        if (!code) {
+            return rows;  // No row ever held it
+        }
+        PredicateKernels::equalUInt32(column.data(), present.size(), *code, rows.data());
+        return liveOnly(std::move(rows));
+    }
+
+    SelectionBitmap matchText(const StringColumn& column, std::string_view text) const {
+        SelectionBitmap rows(present.size());
+        PredicateKernels::containsText(column.blobData(), column.offsetData(), column.size(), text, rows.data());
+        return liveOnly(std::move(rows));
+    }
+
+public:
+    ColumnarSnapshot() = default;
+
+    // New version: this one resized to `rowCount` rows with `changes` (sorted, unique handles)
+    // written over their rows
+    ColumnarSnapshot* patched(std::size_t rowCount, const std::vector<std::pair<AttributeHandle, ColumnarRow>>& changes) const {
+        ColumnarSnapshot* next = new ColumnarSnapshot();  // Text columns are rebuilt below, not copied
+        next->versionNumber = versionNumber + 1;
+        next->liveCount = liveCount;
+        next->present = present;
+        next->present.resize(rowCount, 0);
+        next->timestamps = timestamps;
+        next->timestamps.resize(rowCount, 0);
+        next->priorities = priorities;
+        next->priorities.resize(rowCount, 0);
+        next->statuses = statuses;
+        next->statuses.resize(rowCount);
+        next->authors = authors;
+        next->authors.resize(rowCount);
+        for (const auto& change : changes) {
+            std::size_t row = change.first;
+            if (row >= rowCount) {
+                break;
+            }
+            const ColumnarRow& source = change.second;
+            if (source.present && !next->present[row]) {
+                next->liveCount += 1;
+            } else if (!source.present && next->present[row]) {
+                next->liveCount -= 1;
+            }
+            next->present[row] = source.present ? 1 : 0;
+            next->timestamps[row] = source.present ? static_cast<std::int64_t>(source.timestamp) : 0;
+            next->priorities[row] = source.present ? source.priority : 0;
+            next->statuses.set(row, source.present ? source.status : InternedString());
+            next->authors.set(row, source.present ? source.author : InternedString());
+        }
+        // Ids stay with their handle after a remove
+        next->ids = StringColumn::patched(ids, rowCount, changes, [](const ColumnarRow& row) { return std::string_view(row.id); });
+        next->titles = StringColumn::patched(titles, rowCount, changes, [](const ColumnarRow& row) {
+            return row.present ? std::string_view(row.title) : std::string_view();
+        });
+        next->descriptions = StringColumn::patched(descriptions, rowCount, changes, [](const ColumnarRow& row) {
+            return row.present ? std::string_view(row.description) : std::string_view();
+        });
+        return next;
+    }
+
+    // Shape
+    std::size_t rowCount() const { return present.size(); }  // Handles issued, live or not
+    std::size_t size() const { return liveCount; }  // Live rows
+    std::uint64_t version() const { return versionNumber; }  // Counts refreshes
+
+    // Row access (row = handle)
+    bool isPresent(AttributeHandle row) const { return row < present.size() && present[row]; }
+    std::string_view idAt(AttributeHandle row) const { return ids.at(row); }
+    std::string_view titleAt(AttributeHandle row) const { return titles.at(row); }
+    std::string_view descriptionAt(AttributeHandle row) const { return descriptions.at(row); }
+    std::time_t timestampAt(AttributeHandle row) const { return static_cast<std::time_t>(timestamps[row]); }
+    std::int32_t priorityAt(AttributeHandle row) const { return priorities[row]; }
+    const std::string& statusAt(AttributeHandle row) const { return statuses.at(row); }
+    const std::string& authorAt(AttributeHandle row) const { return authors.at(row); }
+
+    // Raw columns, rowCount() entries each (for custom kernels)
+    const std::uint8_t* presentColumn() const { return present.data(); }
+    const std::int64_t* timestampColumn() const { return timestamps.data(); }
+    const std::int32_t* priorityColumn() const { return priorities.data(); }
+    const DictionaryColumn& statusColumn() const { return statuses; }
+    const DictionaryColumn& authorColumn() const { return authors; }
+    const StringColumn& titleColumn() const { return titles; }
+    const StringColumn& descriptionColumn() const { return descriptions; }
+
+    // Predicate scans: one bit per row, set for live rows matching
+    SelectionBitmap live() const {
+        SelectionBitmap rows(present.size());
+        PredicateKernels::nonZeroUInt8(present.data(), present.size(), rows.data());
+        return rows;
+    }
+
+    SelectionBitmap matchPriority(std::int32_t low, std::int32_t high) const {
+        SelectionBitmap rows(present.size());
+        PredicateKernels::rangeInt32(priorities.data(), priorities.size(), low, high, rows.data());
+        return liveOnly(std::move(rows));
+    }
+
+    SelectionBitmap matchTimestamp(std::time_t from, std::time_t to) const {
+        SelectionBitmap rows(present.size());
+        PredicateKernels::rangeInt64(timestamps.data(), timestamps.size(), from, to, rows.data());
+        return liveOnly(std::move(rows));
+    }
+
+    SelectionBitmap matchStatus(std::string_view status) const {
+        return matchCode(statuses, status);
+    }
+
+    SelectionBitmap matchAuthor(std::string_view author) const {
+        return matchCode(authors, author);
+    }
+
+    // Substring match (case-sensitive)
+    SelectionBitmap matchTitle(std::string_view text) const {
+        return matchText(titles, text);
+    }
+
+    SelectionBitmap matchDescription(std::string_view text) const {
+        return matchText(descriptions, text);
+    }
+
+    // Filters: live rows matching, as handles in ascending order
+    std::vector<AttributeHandle> selectPriority(std::int32_t priority) const {
+        return matchPriority(priority, priority).handles();
+    }
+
+    std::vector<AttributeHandle> selectTimestamp(std::time_t from, std::time_t to) const {
+        return matchTimestamp(from, to).handles();
+    }
+
+    std::vector<AttributeHandle> selectStatus(std::string_view status) const {
+        return matchStatus(status).handles();
+    }
+
+    // Aggregates over live rows
+    std::size_t countPriority(std::int32_t priority) const {
+        return matchPriority(priority, priority).count();
+    }
+
+    std::size_t countTimestamp(std::time_t from, std::time_t to) const {
+        return matchTimestamp(from, to).count();
+    }
+
+    std::size_t countStatus(std::string_view status) const {
+        return matchStatus(status).count();
+    }
+
+    std::size_t countAuthor(std::string_view author) const {
+        return matchAuthor(author).count();
+    }
+
+    // priority -> live rows with it
+    std::map<std::int32_t, std::size_t> countByPriority() const {
+        std::map<std::int32_t, std::size_t> counts;
+        for (std::size_t i = 0; i < present.size(); ++i) {
+            if (present[i]) {
+                counts[priorities[i]] += 1;
+            }
+        }
+        return counts;
+    }
+
+    // status -> live rows with it (statuses never seen on a live row are left out)
+    std::map<std::string, std::size_t> countByStatus() const {
+        std::vector<std::size_t> perCode(statuses.dictionary().size(), 0);
+        const std::uint32_t* column = statuses.data();
+        for (std::size_t i = 0; i < present.size(); ++i) {
+            perCode[column[i]] += present[i];
+        }
+        std::map<std::string, std::size_t> counts;
+        for (std::size_t code = 0; code < perCode.size(); ++code) {
+            if (perCode[code]) {
+                counts[statuses.dictionary()[code].str()] = perCode[code];
+            }
+        }
+        return counts;
+    }
+};
+
+
+
+
+#endif // __COLUMNARSNAPSHOT_HPP__
@@ -0,0 +1,379 @@
+#ifndef __PREDICATEKERNELS_HPP__
+#define __PREDICATEKERNELS_HPP__
+
+
+#include <string_view>
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ARCHINOTE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+
+
+
+// Instruction sets the predicate kernels can use, in increasing order
+enum class SimdLevel {
+    SCALAR,
+    SSE42,
+    AVX2
+};
+
+// Predicate scans over raw column arrays, writing one bit per row
+// Every kernel fills wordsFor(n) 64-bit words of `out` (row i -> bit i % 64 of word i / 64) and
+// leaves the bits past n at 0, matching SelectionBitmap's layout. Each has a scalar version and, on
+// x86 with GCC or Clang, SSE4.2 and AVX2 versions compiled with per-function target attributes, so
+// the binary still runs on any x86-64; the best level the CPU supports is picked once at run time.
+// SIMD versions produce a whole 64-row word per step (compare, then movemask) and finish the last
+// partial word with the scalar loop.
+class PredicateKernels {
+private:
+    static std::atomic<SimdLevel>& current() {
+        static std::atomic<SimdLevel> level{supportedLevel()};
+        return level;
+    }
+
+    static std::size_t fullWords(std::size_t n) { return n / 64; }
+
+    // Scalar bits for rows [64 * firstWord, n): finishes what a SIMD loop left
+    template <typename Pred>
+    static void scalarWords(std::size_t firstWord, std::size_t n, Pred pred, std::uint64_t* out) {
+        for (std::size_t w = firstWord; w * 64 < n; ++w) {
+            std::size_t end = std::min(n, w * 64 + 64);
+            std::uint64_t bits = 0;
+            for (std::size_t i = w * 64; i < end; ++i) {
+                bits |= static_cast<std::uint64_t>(pred(i)) << (i % 64);
+            }
+            out[w] = bits;
+        }
+    }
+
+    // Rows [row, rows) whose text from `pos` on contains `needle`; sets their bits in `out`
+    static void containsFrom(const char* blob, const std::uint32_t* offsets, std::size_t row, std::size_t pos,
+                             std::size_t rows, std::string_view needle, std::uint64_t* out) {
+        for (; row < rows; ++row) {
+            std::size_t start = std::max<std::size_t>(pos, offsets[row]);
+            if (start >= offsets[row + 1]) {
+                continue;
+            }
+            if (std::string_view(blob + start, offsets[row + 1] - start).find(needle) != std::string_view::npos) {
+                out[row / 64] |= std::uint64_t(1) << (row % 64);
+            }
+        }
+    }
+
+#ifdef ARCHINOTE_X86_KERNELS
+    // SSE4.2: 128-bit lanes (4 x int32, 2 x int64, 16 x byte per compare)
+    __attribute__((target("sse4.2")))
+    static void rangeInt32SSE42(const std::int32_t* column, std::size_t n, std::int32_t low, std::int32_t high,
+                                std::uint64_t* out) {
+        const __m128i lo = _mm_set1_epi32(low), hi = _mm_set1_epi32(high);
+        for (std::size_t w = 0; w < fullWords(n); ++w) {
+            std::uint64_t bits = 0;
+            for (std::size_t g = 0; g < 16; ++g) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + w * 64 + g * 4));
+                __m128i outside = _mm_or_si128(_mm_cmpgt_epi32(lo, v), _mm_cmpgt_epi32(v, hi));
+                bits |= static_cast<std::uint64_t>(~_mm_movemask_ps(_mm_castsi128_ps(outside)) & 0xf) << (g * 4);
+            }
+            out[w] = bits;
+        }
+    }
+
+    __attribute__((target("sse4.2")))
+    static void rangeInt64SSE42(const std::int64_t* column, std::size_t n, std::int64_t low, std::int64_t high,
+                                std::uint64_t* out) {
+        const __m128i lo = _mm_set1_epi64x(low), hi = _mm_set1_epi64x(high);
+        for (std::size_t w = 0; w < fullWords(n); ++w) {
+            std::uint64_t bits = 0;
+            for (std::size_t g = 0; g < 32; ++g) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + w * 64 + g * 2));
+                __m128i outside = _mm_or_si128(_mm_cmpgt_epi64(lo, v), _mm_cmpgt_epi64(v, hi));
+                bits |= static_cast<std::uint64_t>(~_mm_movemask_pd(_mm_castsi128_pd(outside)) & 0x3) << (g * 2);
+            }
+            out[w] = bits;
+        }
+    }
+
+    __attribute__((target("sse4.2")))
+    static void equalUInt32SSE42(const std::uint32_t* column, std::size_t n, std::uint32_t value, std::uint64_t* out) {
+        const __m128i wanted = _mm_set1_epi32(static_cast<int>(value));
+        for (std::size_t w = 0; w < fullWords(n); ++w) {
+            std::uint64_t bits = 0;
+            for (std::size_t g = 0; g < 16; ++g) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + w * 64 + g * 4));
+                bits |= static_cast<std::uint64_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(v, wanted)))) << (g * 4);
+            }
+            out[w] = bits;
+        }
+    }
+
+    __attribute__((target("sse4.2")))
+    static void nonZeroUInt8SSE42(const std::uint8_t* column, std::size_t n, std::uint64_t* out) {
+        const __m128i zero = _mm_setzero_si128();
+        for (std::size_t w = 0; w < fullWords(n); ++w) {
+            std::uint64_t bits = 0;
+            for (std::size_t g = 0; g < 4; ++g) {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(column + w * 64 + g * 16));
+                bits |= static_cast<std::uint64_t>(~_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero)) & 0xffff) << (g * 16);
+            }
+            out[w] = bits;
+        }
+    }
+
+    // Substring search: candidates are positions whose first and last needle bytes both match,
+    // 16 (SSE4.2) or 32 (AVX2) positions per step; only those are compared in full. A row stops
+    // being scanned at its first match. Returns the blob position the scalar tail starts from.
+    __attribute__((target("sse4.2")))
+    static std::size_t containsSSE42(const char* blob, const std::uint32_t* offsets, std::size_t rows,
+                                     std::string_view needle, std::size_t& row, std::uint64_t* out) {
+        const std::size_t length = needle.size(), end = offsets[rows];
+        const __m128i first = _mm_set1_epi8(needle.front()), last = _mm_set1_epi8(needle.back());
+        std::size_t pos = offsets[0];
+        while (pos + length - 1 + 16 <= end) {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blob + pos));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(blob + pos + length - 1));
+            std::uint32_t mask = static_cast<std::uint32_t>(
+                _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+            std::size_t next = pos + 16;
+            while (mask) {
+                std::size_t at = pos + static_cast<std::size_t>(__builtin_ctz(mask));
+                mask &= mask - 1;
+                next = std::max(next, containsCandidate(blob, offsets, needle, at, row, pos, mask, out));
+            }
+            pos = next;
+        }
+        return pos;
+    }
+
+    // AVX2: 256-bit lanes (8 x int32, 4 x int64, 32 x byte per compare)
+    __attribute__((target("avx2")))
+    static void rangeInt32AVX2(const std::int32_t* column, std::size_t n, std::int32_t low, std::int32_t high,
+                               std::uint64_t* out) {
+        const __m256i lo = _mm256_set1_epi32(low), hi = _mm256_set1_epi32(high);
+        for (std::size_t w = 0; w < fullWords(n); ++w) {
+            std::uint64_t bits = 0;
+            for (std::size_t g = 0; g < 8; ++g) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + w * 64 + g * 8));
+                __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi32(lo, v), _mm256_cmpgt_epi32(v, hi));
+                bits |= static_cast<std::uint64_t>(~_mm256_movemask_ps(_mm256_castsi256_ps(outside)) & 0xff) << (g * 8);
+            }
+            out[w] = bits;
+        }
+    }
+
+    __attribute__((target("avx2")))
+    static void rangeInt64AVX2(const std::int64_t* column, std::size_t n, std::int64_t low, std::int64_t high,
+                               std::uint64_t* out) {
+        const __m256i lo = _mm256_set1_epi64x(low), hi = _mm256_set1_epi64x(high);
+        for (std::size_t w = 0; w < fullWords(n); ++w) {
+            std::uint64_t bits = 0;
+            for (std::size_t g = 0; g < 16; ++g) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + w * 64 + g * 4));
+                __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi64(lo, v), _mm256_cmpgt_epi64(v, hi));
+                bits |= static_cast<std::uint64_t>(~_mm256_movemask_pd(_mm256_castsi256_pd(outside)) & 0xf) << (g * 4);
+            }
+            out[w] = bits;
+        }
+    }
+
+    __attribute__((target("avx2")))
+    static void equalUInt32AVX2(const std::uint32_t* column, std::size_t n, std::uint32_t value, std::uint64_t* out) {
+        const __m256i wanted = _mm256_set1_epi32(static_cast<int>(value));
+        for (std::size_t w = 0; w < fullWords(n); ++w) {
+            std::uint64_t bits = 0;
+            for (std::size_t g = 0; g < 8; ++g) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + w * 64 + g * 8));
+                bits |= static_cast<std::uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, wanted)))) << (g * 8);
+            }
+            out[w] = bits;
+        }
+    }
+
+    __attribute__((target("avx2")))
+    static void nonZeroUInt8AVX2(const std::uint8_t* column, std::size_t n, std::uint64_t* out) {
+        const __m256i zero = _mm256_setzero_si256();
+        for (std::size_t w = 0; w < fullWords(n); ++w) {
+            std::uint64_t bits = 0;
+            for (std::size_t g = 0; g < 2; ++g) {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(column + w * 64 + g * 32));
+                std::uint32_t zeros = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero)));
+                bits |= static_cast<std::uint64_t>(~zeros) << (g * 32);
+            }
+            out[w] = bits;
+        }
+    }
+
+    __attribute__((target("avx2")))
+    static std::size_t containsAVX2(const char* blob, const std::uint32_t* offsets, std::size_t rows,
+                                    std::string_view needle, std::size_t& row, std::uint64_t* out) {
+        const std::size_t length = needle.size(), end = offsets[rows];
+        const __m256i first = _mm256_set1_epi8(needle.front()), last = _mm256_set1_epi8(needle.back());
+        std::size_t pos = offsets[0];
+        while (pos + length - 1 + 32 <= end) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blob + pos));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(blob + pos + length - 1));
+            std::uint32_t mask = static_cast<std::uint32_t>(
+                _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+            std::size_t next = pos + 32;
+            while (mask) {
+                std::size_t at = pos + static_cast<std::size_t>(__builtin_ctz(mask));
+                mask &= mask - 1;
+                next = std::max(next, containsCandidate(blob, offsets, needle, at, row, pos, mask, out));
+            }
+            pos = next;
+        }
+        return pos;
+    }
+
+    // Verify the candidate at blob position `at` (row advances to the row holding it). On a match,
+    // sets the row's bit, drops the rest of the row's candidates from `mask` (bit k = pos + k) and
+    // returns the row's end as the next scan position; otherwise returns 0
+    static std::size_t containsCandidate(const char* blob, const std::uint32_t* offsets, std::string_view needle,
+                                         std::size_t at, std::size_t& row, std::size_t pos, std::uint32_t& mask,
+                                         std::uint64_t* out) {
+        while (offsets[row + 1] <= at) {
+            ++row;
+        }
+        std::size_t rowEnd = offsets[row + 1];
+        if (at + needle.size() > rowEnd ||
+            (needle.size() > 2 && std::memcmp(blob + at + 1, needle.data() + 1, needle.size() - 2) != 0)) {
+            return 0;
+        }
+        out[row / 64] |= std::uint64_t(1) << (row % 64);
+        mask = rowEnd - pos >= 32 ? 0 : mask & ~((std::uint32_t(1) << (rowEnd - pos)) - 1);
+        return rowEnd;
+    }
+#endif
+
+public:
+    // Best level this CPU supports (detected once)
+    static SimdLevel supportedLevel() {
+#ifdef ARCHINOTE_X86_KERNELS
+        static const SimdLevel detected = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2")) {
+                return SimdLevel::AVX2;
+            }
+            return __builtin_cpu_supports("sse4.2") ? SimdLevel::SSE42 : SimdLevel::SCALAR;
+        }();
+        return detected;
+#else
+        return SimdLevel::SCALAR;
+#endif
+    }
+
+    // Level the kernels dispatch to; defaults to supportedLevel()
+    static SimdLevel level() { return current().load(std::memory_order_relaxed); }
+
+    // Pin a lower level (benchmarks, cross-checking); clamped to supportedLevel()
+    static void setLevel(SimdLevel wanted) {
+        current().store(std::min(wanted, supportedLevel()));
+    }
+
+    static const char* levelName(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::AVX2: return "AVX2";
+            case SimdLevel::SSE42: return "SSE4.2";
+            default: return "scalar";
+        }
+    }
+
+    // low <= column[i] <= high
+    static void rangeInt32(const std::int32_t* column, std::size_t n, std::int32_t low, std::int32_t high,
+                           std::uint64_t* out) {
+        std::size_t done = 0;
+#ifdef ARCHINOTE_X86_KERNELS
+        SimdLevel use = level();
+        if (use == SimdLevel::AVX2) {
+            rangeInt32AVX2(column, n, low, high, out);
+            done = fullWords(n);
+        } else if (use == SimdLevel::SSE42) {
+            rangeInt32SSE42(column, n, low, high, out);
+            done = fullWords(n);
+        }
+#endif
+        scalarWords(done, n, [column, low, high](std::size_t i) { return (column[i] >= low) & (column[i] <= high); }, out);
+    }
+
+    static void rangeInt64(const std::int64_t* column, std::size_t n, std::int64_t low, std::int64_t high,
+                           std::uint64_t* out) {
+        std::size_t done = 0;
+#ifdef ARCHINOTE_X86_KERNELS
+        SimdLevel use = level();
+        if (use == SimdLevel::AVX2) {
+            rangeInt64AVX2(column, n, low, high, out);
+            done = fullWords(n);
+        } else if (use == SimdLevel::SSE42) {
+            rangeInt64SSE42(column, n, low, high, out);
+            done = fullWords(n);
+        }
+#endif
+        scalarWords(done, n, [column, low, high](std::size_t i) { return (column[i] >= low) & (column[i] <= high); }, out);
+    }
+
+    // column[i] == value (dictionary codes)
+    static void equalUInt32(const std::uint32_t* column, std::size_t n, std::uint32_t value, std::uint64_t* out) {
+        std::size_t done = 0;
+#ifdef ARCHINOTE_X86_KERNELS
+        SimdLevel use = level();
+        if (use == SimdLevel::AVX2) {
+            equalUInt32AVX2(column, n, value, out);
+            done = fullWords(n);
+        } else if (use == SimdLevel::SSE42) {
+            equalUInt32SSE42(column, n, value, out);
+            done = fullWords(n);
+        }
+#endif
+        scalarWords(done, n, [column, value](std::size_t i) { return column[i] == value; }, out);
+    }
+
+    // column[i] != 0 (presence flags)
+    static void nonZeroUInt8(const std::uint8_t* column, std::size_t n, std::uint64_t* out) {
+        std::size_t done = 0;
+#ifdef ARCHINOTE_X86_KERNELS
+        SimdLevel use = level();
+        if (use == SimdLevel::AVX2) {
+            nonZeroUInt8AVX2(column, n, out);
+            done = fullWords(n);
+        } else if (use == SimdLevel::SSE42) {
+            nonZeroUInt8SSE42(column, n, out);
+            done = fullWords(n);
+        }
+#endif
+        scalarWords(done, n, [column](std::size_t i) { return column[i] != 0; }, out);
+    }
+
+    // Row i's text, blob[offsets[i], offsets[i + 1]), contains `needle` (case-sensitive bytes).
+    // An empty needle matches every row
+    static void containsText(const char* blob, const std::uint32_t* offsets, std::size_t n, std::string_view needle,
+                             std::uint64_t* out) {
+        std::fill(out, out + (n + 63) / 64, 0);
+        if (needle.empty()) {
+            scalarWords(0, n, [](std::size_t) { return true; }, out);
+            return;
+        }
+        std::size_t row = 0, pos = n ? offsets[0] : 0;
+#ifdef ARCHINOTE_X86_KERNELS
+        SimdLevel use = level();
+        if (n && use == SimdLevel::AVX2) {
+            pos = containsAVX2(blob, offsets, n, needle, row, out);
+        } else if (n && use == SimdLevel::SSE42) {
+            pos = containsSSE42(blob, offsets, n, needle, row, out);
+        }
+#endif
+        while (row < n && offsets[row + 1] <= pos) {
+            ++row;
+        }
+        containsFrom(blob, offsets, row, pos, n, needle, out);
+    }
+};
+
+
+
+
+#endif // __PREDICATEKERNELS_HPP__
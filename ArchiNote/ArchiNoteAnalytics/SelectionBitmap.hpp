@@ -0,0 +1,147 @@
+#ifndef __SELECTIONBITMAP_HPP__
+#define __SELECTIONBITMAP_HPP__
+
+
+#include <string>
+#include <vector>
+#include <bitset>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+
+#include "../ArchiNoteIndex/IdRegistry.hpp"
+
+
+
+
+// One bit per ColumnarSnapshot row: the result of a predicate scan
+// Bit i is bit (i % 64) of word i / 64; bits past size() are always 0, so count() and the
+// combinators never need to mask the last word. Results of scans over the same snapshot have the
+// same size and combine with &, | and andNot() into compound filters.
+class SelectionBitmap {
+private:
+    std::vector<std::uint64_t> words;
+    std::size_t bitCount = 0;
+
+    void clearTail() {
+        if (bitCount % 64 != 0) {
+            words.back() &= (std::uint64_t(1) << (bitCount % 64)) - 1;
+        }
+    }
+
+    void requireSameSize(const SelectionBitmap& other) const {
+        if (other.bitCount != bitCount) {
+            throw std::invalid_argument("SelectionBitmap: size mismatch (" + std::to_string(bitCount) +
+                                        " vs " + std::to_string(other.bitCount) + " rows)");
+        }
+    }
+
+public:
+    explicit SelectionBitmap(std::size_t size = 0, bool value = false)
+        : words(wordsFor(size), value ? ~std::uint64_t(0) : 0), bitCount(size) {
+        clearTail();
+    }
+
+    static std::size_t wordsFor(std::size_t size) { return (size + 63) / 64; }
+
+    std::size_t size() const { return bitCount; }
+
+    bool test(std::size_t row) const {
+        return row < bitCount && ((words[row / 64] >> (row % 64)) & 1);
+    }
+
+    void set(std::size_t row, bool value = true) {
+        if (row >= bitCount) {
+            throw std::out_of_range("SelectionBitmap: row " + std::to_string(row) + " out of range");
+        }
+        std::uint64_t bit = std::uint64_t(1) << (row % 64);
+        words[row / 64] = value ? (words[row / 64] | bit) : (words[row / 64] & ~bit);
+    }
+
+    // Selected rows
+    std::size_t count() const {
+        std::size_t total = 0;
+        for (std::uint64_t word : words) {
+            total += std::bitset<64>(word).count();
+        }
+        return total;
+    }
+
+    bool any() const {
+        for (std::uint64_t word : words) {
+            if (word) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Combinators (same size only)
+    SelectionBitmap& operator&=(const SelectionBitmap& other) {
+        requireSameSize(other);
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            words[i] &= other.words[i];
+        }
+        return *this;
+    }
+
+    SelectionBitmap& operator|=(const SelectionBitmap& other) {
+        requireSameSize(other);
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            words[i] |= other.words[i];
+        }
+        return *this;
+    }
+
+    // Remove the rows selected in `other`
+    SelectionBitmap& andNot(const SelectionBitmap& other) {
+        requireSameSize(other);
+        for (std::size_t i = 0; i < words.size(); ++i) {
+            words[i] &= ~other.words[i];
+        }
+        return *this;
+    }
+
+    // Complement (within size()). Note this selects removed rows too; & with live() to drop them
+    SelectionBitmap operator~() const {
+        SelectionBitmap result(*this);
+        for (std::uint64_t& word : result.words) {
+            word = ~word;
+        }
+        result.clearTail();
+        return result;
+    }
+
+    friend SelectionBitmap operator&(SelectionBitmap a, const SelectionBitmap& b) { return a &= b; }
+    friend SelectionBitmap operator|(SelectionBitmap a, const SelectionBitmap& b) { return a |= b; }
+
+    // Selected rows as handles, ascending
+    std::vector<AttributeHandle> handles() const {
+        std::vector<AttributeHandle> rows;
+        rows.reserve(count());
+        forEach([&rows](AttributeHandle row) { rows.push_back(row); });
+        return rows;
+    }
+
+    // fn(handle) for each selected row, ascending
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (std::size_t w = 0; w < words.size(); ++w) {
+            for (std::uint64_t word = words[w]; word; ) {
+                std::uint64_t lowest = word & (~word + 1);
+                fn(static_cast<AttributeHandle>(w * 64 + std::bitset<64>(lowest - 1).count()));
+                word ^= lowest;
+            }
+        }
+    }
+
+    // Raw words, for kernels writing results in place. Writers must keep the bits past size() at 0
+    std::uint64_t* data() { return words.data(); }
+    const std::uint64_t* data() const { return words.data(); }
+    std::size_t wordCount() const { return words.size(); }
+};
+
+
+
+
+#endif // __SELECTIONBITMAP_HPP__
@@ -6,6 +6,7 @@
 
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 #include <map>
 #include <memory>
@@ -13,13 +14,14 @@
 
 
 #include "../../Enums/ArchiNoteAttributeRelationType.hpp"
-#include "../../Structs/AttributeMetaData.hpp"
+#include "../../Structs/AttributeMetadata.hpp"
 
 
 
 #include "../../Structs/ExportEvent.hpp"
 #include "../../Structs/UpdateEvent.hpp"
 #include "../../Structs/ValidationEvent.hpp"
+#include "../../ArchiNoteVersioning/ContentBlobStore.hpp"
 #include "../../Structs/ProjectBriefContent/AssumptionContent.hpp"
 
 
@@ -35,19 +37,24 @@ class VersionedAssumptions {
 private:
     AttributeMetadata metadata;  // Composed metadata (has-a)
     AssumptionsContent content;  // Concrete content (stack-allocated, no pointer)
+    ContentBlobStore* versionStore;  // Holds the history versions (not owned)
 
 public:
     // Constructor: Use static factory for content
     VersionedAssumptions(const std::string& objId, const std::string& assumption, const std::string& rationale) 
+        : VersionedAssumptions(objId, AssumptionsContent::CreateAssumptionsContent(assumption, rationale)) {}
+
+    // Constructor from already-validated content (moved in); history goes to `store` (null: the shared one)
+    VersionedAssumptions(const std::string& objId, AssumptionsContent initialContent, ContentBlobStore* store = nullptr)
         : metadata(objId, ArchiNoteAttributeType::ASSUMPTIONS),
-          content(AssumptionsContent::CreateAssumptionsContent(assumption, rationale)) {
-        metadata.history.push_back(new AssumptionsContent(content));  // Clone for history
+          content(std::move(initialContent)), versionStore(store ? store : &ContentBlobStore::shared()) {
+        metadata.history.push_back(versionStore->putVersion(content.toJSON()));  // Version ref
     }
 
     // Destructor: Manual cleanup for history in metadata
     ~VersionedAssumptions() {
-        for (void* ptr : metadata.history) {
-            delete static_cast<AssumptionsContent*>(ptr);  // Manual delete
+        for (std::uint64_t ref : metadata.history) {
+            versionStore->releaseVersion(ref);
         }
         metadata.history.clear();
     }
@@ -58,34 +65,66 @@ public:
 
     // Move constructor/assignment
     VersionedAssumptions(VersionedAssumptions&& other) noexcept 
-        : metadata(std::move(other.metadata)), content(std::move(other.content)) {}
+        : metadata(std::move(other.metadata)), content(std::move(other.content)), versionStore(other.versionStore) {}
 
     VersionedAssumptions& operator=(VersionedAssumptions&& other) noexcept {
         if (this != &other) {
-            for (void* ptr : metadata.history) {
-                delete static_cast<AssumptionsContent*>(ptr);
+            for (std::uint64_t ref : metadata.history) {
+                versionStore->releaseVersion(ref);
             }
             metadata.history.clear();
             metadata = std::move(other.metadata);
             content = std::move(other.content);
+            versionStore = other.versionStore;
         }
         return *this;
     }
 
     // Getters for metadata
-    std::string getID() const { return metadata.id; }
+    const std::string& getID() const { return metadata.id; }
     ArchiNoteAttributeType getType() const { return metadata.type; }
     const std::vector<ArchiNoteAttributeRelationType>& getRelations() const { return metadata.relations; }
+    const std::string& getAuthor() const { return metadata.author; }
+    InternedString getAuthorHandle() const { return metadata.author; }  // For integer-compare indexes
+    std::time_t getTimestamp() const { return metadata.timestamp; }
+    const AssumptionsContent& getContent() const { return content; }
+
+    // Setters for metadata (author of the last change; timestamp when restoring a stored record)
+    void setAuthor(std::string_view newAuthor) { metadata.author = InternedString(newAuthor); }
+    void setTimestamp(std::time_t newTimestamp) { metadata.timestamp = newTimestamp; }
+
+    // Restoring a stored record: adopt its history refs from the version store. Refs the store
+    // does not hold (history never persisted) are dropped; if none is left the current one stays
+    void restoreHistory(const std::vector<std::uint64_t>& refs) {
+        std::vector<std::uint64_t> restored;
+        for (std::uint64_t ref : refs) {
+            if (versionStore->retainVersion(ref)) {
+                restored.push_back(ref);
+            }
+        }
+        if (restored.empty()) {
+            return;
+        }
+        for (std::uint64_t ref : metadata.history) {
+            versionStore->releaseVersion(ref);
+        }
+        metadata.history = std::move(restored);
+    }
 
     // Content-specific methods
     void updateContent(const std::string& newAssumption, const std::string& newRationale) {
+        updateContent(AssumptionsContent::CreateAssumptionsContent(newAssumption, newRationale));
+    }
+
+    // Replace the content with an already-validated one (moved in)
+    void updateContent(AssumptionsContent newContent) {
         // Save old content to history
-        metadata.history.push_back(new AssumptionsContent(content));  // Deep copy
+        metadata.history.push_back(versionStore->putVersion(content.toJSON()));  // Shared, deduplicated
         std::time_t now = std::time(nullptr);
         metadata.changeLog[now] = "Updated assumptions content";
 
-        // Update content (direct assignment via factory)
-        content = AssumptionsContent::CreateAssumptionsContent(newAssumption, newRationale);
+        // Update content
+        content = std::move(newContent);
 
         // Update metadata timestamp
         metadata.timestamp = now;
@@ -99,18 +138,21 @@ public:
 
     std::string toFullJSON() const {
         // Metadata JSON
-        std::string json = "{ \"metadata\": { \"id\": \"" + metadata.id + "\", \"type\": " + std::to_string(static_cast<int>(metadata.type)) + 
-                           ", \"timestamp\": " + std::to_string(metadata.timestamp) + " }, ";
+        std::string json = "{ \"metadata\": { \"id\": \"" + JSONFields::escape(metadata.id) + "\", \"type\": " + std::to_string(static_cast<int>(metadata.type)) + 
+                           ", \"timestamp\": " + std::to_string(metadata.timestamp) +
+                           ", \"author\": \"" + JSONFields::escape(metadata.author) + "\"" +
+                           ", \"history\": " + ContentBlobStore::refListJSON(metadata.history) + " }, ";
         // Content JSON
         json += "\"content\": " + content.toJSON() + " }";
         return json;
     }
 
-    // Get history (cast back to AssumptionsContent)
-    std::vector<AssumptionsContent*> getHistory() const {
-        std::vector<AssumptionsContent*> result;
-        for (void* ptr : metadata.history) {
-            result.push_back(static_cast<AssumptionsContent*>(ptr));
+    // Get history (re-assembled from the version store, oldest first)
+    std::vector<AssumptionsContent> getHistory() const {
+        std::vector<AssumptionsContent> result;
+        result.reserve(metadata.history.size());
+        for (std::uint64_t ref : metadata.history) {
+            result.push_back(AssumptionsContent::FromJSON(versionStore->getVersion(ref)));
         }
         return result;
     }
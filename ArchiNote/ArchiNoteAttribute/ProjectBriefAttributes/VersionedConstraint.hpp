@@ -4,13 +4,14 @@
 
 
 #include "../../Enums/ArchiNoteAttributeRelationType.hpp"
-#include "../../Structs/AttributeMetaData.hpp"
+#include "../../Structs/AttributeMetadata.hpp"
 
 
 
 #include "../../Structs/ExportEvent.hpp"
 #include "../../Structs/UpdateEvent.hpp"
 #include "../../Structs/ValidationEvent.hpp"
+#include "../../ArchiNoteVersioning/ContentBlobStore.hpp"
 #include "../../Structs/ProjectBriefContent/ConstraintContent.hpp"
 
 
@@ -23,19 +24,24 @@ class VersionedConstraint {
 private:
     AttributeMetadata metadata;  // Composed metadata (has-a)
     ConstraintContent content;  // Concrete content (stack-allocated, no pointer)
+    ContentBlobStore* versionStore;  // Holds the history versions (not owned)
 
 public:
     // Constructor: Use static factory for content
     VersionedConstraint(const std::string& objId, const std::string& constraint, const std::string& impact) 
+        : VersionedConstraint(objId, ConstraintContent::CreateConstraintsContent(constraint, impact)) {}
+
+    // Constructor from already-validated content (moved in); history goes to `store` (null: the shared one)
+    VersionedConstraint(const std::string& objId, ConstraintContent initialContent, ContentBlobStore* store = nullptr)
         : metadata(objId, ArchiNoteAttributeType::CONSTRAINTS),
-          content(ConstraintContent::CreateConstraintsContent(constraint, impact)) {
-        metadata.history.push_back(new ConstraintContent(content));  // Clone for history
+          content(std::move(initialContent)), versionStore(store ? store : &ContentBlobStore::shared()) {
+        metadata.history.push_back(versionStore->putVersion(content.toJSON()));  // Version ref
     }
 
     // Destructor: Manual cleanup for history in metadata
     ~VersionedConstraint() {
-        for (void* ptr : metadata.history) {
-            delete static_cast<ConstraintContent*>(ptr);  // Manual delete
+        for (std::uint64_t ref : metadata.history) {
+            versionStore->releaseVersion(ref);
         }
         metadata.history.clear();
     }
@@ -46,34 +52,66 @@ public:
 
     // Move constructor/assignment
     VersionedConstraint(VersionedConstraint&& other) noexcept 
-        : metadata(std::move(other.metadata)), content(std::move(other.content)) {}
+        : metadata(std::move(other.metadata)), content(std::move(other.content)), versionStore(other.versionStore) {}
 
     VersionedConstraint& operator=(VersionedConstraint&& other) noexcept {
         if (this != &other) {
-            for (void* ptr : metadata.history) {
-                delete static_cast<ConstraintContent*>(ptr);
+            for (std::uint64_t ref : metadata.history) {
+                versionStore->releaseVersion(ref);
             }
             metadata.history.clear();
             metadata = std::move(other.metadata);
             content = std::move(other.content);
+            versionStore = other.versionStore;
         }
         return *this;
     }
 
     // Getters for metadata
-    std::string getID() const { return metadata.id; }
+    const std::string& getID() const { return metadata.id; }
     ArchiNoteAttributeType getType() const { return metadata.type; }
     const std::vector<ArchiNoteAttributeRelationType>& getRelations() const { return metadata.relations; }
+    const std::string& getAuthor() const { return metadata.author; }
+    InternedString getAuthorHandle() const { return metadata.author; }  // For integer-compare indexes
+    std::time_t getTimestamp() const { return metadata.timestamp; }
+    const ConstraintContent& getContent() const { return content; }
+
+    // Setters for metadata (author of the last change; timestamp when restoring a stored record)
+    void setAuthor(std::string_view newAuthor) { metadata.author = InternedString(newAuthor); }
+    void setTimestamp(std::time_t newTimestamp) { metadata.timestamp = newTimestamp; }
+
+    // Restoring a stored record: adopt its history refs from the version store. Refs the store
+    // does not hold (history never persisted) are dropped; if none is left the current one stays
+    void restoreHistory(const std::vector<std::uint64_t>& refs) {
+        std::vector<std::uint64_t> restored;
+        for (std::uint64_t ref : refs) {
+            if (versionStore->retainVersion(ref)) {
+                restored.push_back(ref);
+            }
+        }
+        if (restored.empty()) {
+            return;
+        }
+        for (std::uint64_t ref : metadata.history) {
+            versionStore->releaseVersion(ref);
+        }
+        metadata.history = std::move(restored);
+    }
 
     // Content-specific methods
     void updateContent(const std::string& newConstraint, const std::string& newImpact) {
+        updateContent(ConstraintContent::CreateConstraintsContent(newConstraint, newImpact));
+    }
+
+    // Replace the content with an already-validated one (moved in)
+    void updateContent(ConstraintContent newContent) {
         // Save old content to history
-        metadata.history.push_back(new ConstraintContent(content));  // Deep copy
+        metadata.history.push_back(versionStore->putVersion(content.toJSON()));  // Shared, deduplicated
         std::time_t now = std::time(nullptr);
         metadata.changeLog[now] = "Updated constraints content";
 
-        // Update content (direct assignment via factory)
-        content = ConstraintContent::CreateConstraintsContent(newConstraint, newImpact);
+        // Update content
+        content = std::move(newContent);
 
         // Update metadata timestamp
         metadata.timestamp = now;
@@ -87,18 +125,21 @@ public:
 
     std::string toFullJSON() const {
         // Metadata JSON
-        std::string json = "{ \"metadata\": { \"id\": \"" + metadata.id + "\", \"type\": " + std::to_string(static_cast<int>(metadata.type)) + 
-                           ", \"timestamp\": " + std::to_string(metadata.timestamp) + " }, ";
+        std::string json = "{ \"metadata\": { \"id\": \"" + JSONFields::escape(metadata.id) + "\", \"type\": " + std::to_string(static_cast<int>(metadata.type)) + 
+                           ", \"timestamp\": " + std::to_string(metadata.timestamp) +
+                           ", \"author\": \"" + JSONFields::escape(metadata.author) + "\"" +
+                           ", \"history\": " + ContentBlobStore::refListJSON(metadata.history) + " }, ";
         // Content JSON
         json += "\"content\": " + content.toJSON() + " }";
         return json;
     }
 
-    // Get history (cast back to ConstraintsContent)
-    std::vector<ConstraintContent*> getHistory() const {
-        std::vector<ConstraintContent*> result;
-        for (void* ptr : metadata.history) {
-            result.push_back(static_cast<ConstraintContent*>(ptr));
+    // Get history (re-assembled from the version store, oldest first)
+    std::vector<ConstraintContent> getHistory() const {
+        std::vector<ConstraintContent> result;
+        result.reserve(metadata.history.size());
+        for (std::uint64_t ref : metadata.history) {
+            result.push_back(ConstraintContent::FromJSON(versionStore->getVersion(ref)));
         }
         return result;
     }
@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <string>
+#include <utility>
 #include <vector>
 #include <map>
 #include <memory>
@@ -14,13 +15,14 @@
 
 
 #include "../../Enums/ArchiNoteAttributeRelationType.hpp"
-#include "../../Structs/AttributeMetaData.hpp"
+#include "../../Structs/AttributeMetadata.hpp"
 
 
 
 #include "../../Structs/ExportEvent.hpp"
 #include "../../Structs/UpdateEvent.hpp"
 #include "../../Structs/ValidationEvent.hpp"
+#include "../../ArchiNoteVersioning/ContentBlobStore.hpp"
 #include "../../Structs/ProjectBriefContent/PainPointContent.hpp"
 
 
@@ -33,19 +35,24 @@ class VersionedPainPoints {
 private:
     AttributeMetadata metadata;  // Composed metadata (has-a)
     PainPointContent content;  // Concrete content (stack-allocated, no pointer)
+    ContentBlobStore* versionStore;  // Holds the history versions (not owned)
 
 public:
     // Constructor: Use static factory for content
     VersionedPainPoints(const std::string& objId, const std::string& issue, const std::string& impact, const std::string& stakeholders) 
+        : VersionedPainPoints(objId, PainPointContent::CreatePainPointsContent(issue, impact, stakeholders)) {}
+
+    // Constructor from already-validated content (moved in); history goes to `store` (null: the shared one)
+    VersionedPainPoints(const std::string& objId, PainPointContent initialContent, ContentBlobStore* store = nullptr)
         : metadata(objId, ArchiNoteAttributeType::PAIN_POINTS),
-          content(PainPointContent::CreatePainPointsContent(issue, impact, stakeholders)) {
-        metadata.history.push_back(new PainPointContent(content));  // Clone for history
+          content(std::move(initialContent)), versionStore(store ? store : &ContentBlobStore::shared()) {
+        metadata.history.push_back(versionStore->putVersion(content.toJSON()));  // Version ref
     }
 
     // Destructor: Manual cleanup for history in metadata
     ~VersionedPainPoints() {
-        for (void* ptr : metadata.history) {
-            delete static_cast<PainPointContent*>(ptr);  // Manual delete
+        for (std::uint64_t ref : metadata.history) {
+            versionStore->releaseVersion(ref);
         }
         metadata.history.clear();
     }
@@ -56,34 +63,66 @@ public:
 
     // Move constructor/assignment
     VersionedPainPoints(VersionedPainPoints&& other) noexcept 
-        : metadata(std::move(other.metadata)), content(std::move(other.content)) {}
+        : metadata(std::move(other.metadata)), content(std::move(other.content)), versionStore(other.versionStore) {}
 
     VersionedPainPoints& operator=(VersionedPainPoints&& other) noexcept {
         if (this != &other) {
-            for (void* ptr : metadata.history) {
-                delete static_cast<PainPointContent*>(ptr);
+            for (std::uint64_t ref : metadata.history) {
+                versionStore->releaseVersion(ref);
             }
             metadata.history.clear();
             metadata = std::move(other.metadata);
             content = std::move(other.content);
+            versionStore = other.versionStore;
         }
         return *this;
     }
 
     // Getters for metadata
-    std::string getID() const { return metadata.id; }
+    const std::string& getID() const { return metadata.id; }
     ArchiNoteAttributeType getType() const { return metadata.type; }
     const std::vector<ArchiNoteAttributeRelationType>& getRelations() const { return metadata.relations; }
+    const std::string& getAuthor() const { return metadata.author; }
+    InternedString getAuthorHandle() const { return metadata.author; }  // For integer-compare indexes
+    std::time_t getTimestamp() const { return metadata.timestamp; }
+    const PainPointContent& getContent() const { return content; }
+
+    // Setters for metadata (author of the last change; timestamp when restoring a stored record)
+    void setAuthor(std::string_view newAuthor) { metadata.author = InternedString(newAuthor); }
+    void setTimestamp(std::time_t newTimestamp) { metadata.timestamp = newTimestamp; }
+
+    // Restoring a stored record: adopt its history refs from the version store. Refs the store
+    // does not hold (history never persisted) are dropped; if none is left the current one stays
+    void restoreHistory(const std::vector<std::uint64_t>& refs) {
+        std::vector<std::uint64_t> restored;
+        for (std::uint64_t ref : refs) {
+            if (versionStore->retainVersion(ref)) {
+                restored.push_back(ref);
+            }
+        }
+        if (restored.empty()) {
+            return;
+        }
+        for (std::uint64_t ref : metadata.history) {
+            versionStore->releaseVersion(ref);
+        }
+        metadata.history = std::move(restored);
+    }
 
     // Content-specific methods
     void updateContent(const std::string& newIssue, const std::string& newImpact, const std::string& newStakeholders) {
+        updateContent(PainPointContent::CreatePainPointsContent(newIssue, newImpact, newStakeholders));
+    }
+
+    // Replace the content with an already-validated one (moved in)
+    void updateContent(PainPointContent newContent) {
         // Save old content to history
-        metadata.history.push_back(new PainPointContent(content));  // Deep copy
+        metadata.history.push_back(versionStore->putVersion(content.toJSON()));  // Shared, deduplicated
         std::time_t now = std::time(nullptr);
         metadata.changeLog[now] = "Updated pain points content";
 
-        // Update content (direct assignment via factory)
-        content = PainPointContent::CreatePainPointsContent(newIssue, newImpact, newStakeholders);
+        // Update content
+        content = std::move(newContent);
 
         // Update metadata timestamp
         metadata.timestamp = now;
@@ -97,18 +136,21 @@ public:
 
     std::string toFullJSON() const {
         // Metadata JSON
-        std::string json = "{ \"metadata\": { \"id\": \"" + metadata.id + "\", \"type\": " + std::to_string(static_cast<int>(metadata.type)) + 
-                           ", \"timestamp\": " + std::to_string(metadata.timestamp) + " }, ";
+        std::string json = "{ \"metadata\": { \"id\": \"" + JSONFields::escape(metadata.id) + "\", \"type\": " + std::to_string(static_cast<int>(metadata.type)) + 
+                           ", \"timestamp\": " + std::to_string(metadata.timestamp) +
+                           ", \"author\": \"" + JSONFields::escape(metadata.author) + "\"" +
+                           ", \"history\": " + ContentBlobStore::refListJSON(metadata.history) + " }, ";
         // Content JSON
         json += "\"content\": " + content.toJSON() + " }";
         return json;
     }
 
-    // Get history (cast back to PainPointsContent)
-    std::vector<PainPointContent*> getHistory() const {
-        std::vector<PainPointContent*> result;
-        for (void* ptr : metadata.history) {
-            result.push_back(static_cast<PainPointContent*>(ptr));
+    // Get history (re-assembled from the version store, oldest first)
+    std::vector<PainPointContent> getHistory() const {
+        std::vector<PainPointContent> result;
+        result.reserve(metadata.history.size());
+        for (std::uint64_t ref : metadata.history) {
+            result.push_back(PainPointContent::FromJSON(versionStore->getVersion(ref)));
         }
         return result;
     }
@@ -0,0 +1,979 @@
+#ifndef __ATTRIBUTEREPOAGENT_HPP__
+#define __ATTRIBUTEREPOAGENT_HPP__
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <map>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <stdexcept>
+#include <sstream>
+#include <ctime>
+#include <cstdlib>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <memory>
+#include <algorithm>
+#include <optional>
+
+#include "IAttributeRepoAgent.hpp"
+#include "../ArchiNoteMemory/ObjectPool.hpp"
+#include "../ArchiNoteMemory/StringInterner.hpp"
+#include "../ArchiNoteVersioning/ContentBlobStore.hpp"
+#include "../ArchiNoteConcurrency/Strand.hpp"
+#include "../ArchiNoteConcurrency/ShardedMap.hpp"
+#include "../ArchiNoteConcurrency/AttributeSnapshot.hpp"
+#include "../ArchiNoteIndex/IdRegistry.hpp"
+#include "../ArchiNoteIndex/SecondaryIndex.hpp"
+#include "../ArchiNoteIndex/InvertedIndex.hpp"
+#include "../ArchiNoteIndex/CompletionIndex.hpp"
+#include "../ArchiNoteStorage/IStorageAdapter.hpp"
+#include "../Structs/JSONFields.hpp"
+#include "../Structs/BatchResult.hpp"
+
+
+
+
+// Generic Repo Agent over one Versioned attribute type
+// Attributes are allocated from a slab pool and found through a hash index on their id, so every
+// id lookup (create's duplicate check, read, update, remove, serialization) is O(1) on average.
+// Concrete agents only supply the type-specific parts: param parsing and validation, the YAML
+// content block and the text fed to the search indexes.
+// Creates and updates take a typed TParams (string_views into caller-owned text, plain ints/bools):
+// validation reads the views in place and TContent::FromParams() allocates each field once, moved
+// straight into the pooled attribute. The std::map overloads required by IAttributeRepoAgent are a
+// thin adapter that parses the map into a TParams viewing the map's own strings.
+// Optional secondary indexes (author, timestamp, plus any content keys a concrete agent adds) are
+// built by enableSecondaryIndexes() and then kept current by create/update/remove/loadFromJSON.
+// The same operations feed contentText() into a shared full-text index and ids/completionTitle()
+// into a shared autocomplete index, when those are attached.
+// The *Async operations go through a Strand on the attached executor: they never block the caller
+// and run one at a time per agent, in submission order.
+// Thread safety: the id index is a ShardedMap. Lookups and serialization hold the id's shard
+// read-locked, create/update/remove hold it write-locked up to and including the storage write, so
+// readers run in parallel and writers only meet when their ids share a shard. The pool and the
+// secondary indexes have their own locks, taken inside the shard lock; the attach/enable calls
+// lock every shard. Pointers from read()/tryRead()/find() are only safe while no other thread can
+// update or remove that id; concurrent callers use visit() instead.
+// Snapshot mode (enableSnapshots()) goes further for read-mostly consumers such as export: every
+// write also publishes a new AttributeSnapshot through an RcuCell, and snapshot() pins the current
+// one with no lock at all. Writers publish after the in-memory change, under the same shard lock.
+// Each agent keeps its attributes' version history in a ContentBlobStore of its own, so history
+// is packed into one arena per agent and the destructor drops it wholesale instead of releasing it
+// version by version.
+// For analytics, columnarSnapshot() keeps a ColumnarSnapshot (row = id handle) that writes mark
+// dirty by handle; a refresh re-reads only those rows and patches them into a new snapshot.
+template <typename TVersioned, typename TContent, typename TParams>
+class AttributeRepoAgent : public IAttributeRepoAgent {
+private:
+    typedef ShardedMap<TVersioned*> Index;
+
+    ContentBlobStore* versionStore = new ContentBlobStore();  // History of the pooled attributes
+    ObjectPool<TVersioned> pool;  // Owns the attributes
+    mutable std::mutex poolMutex;  // Guards pool; taken inside a shard lock
+    Index index;  // id -> attribute in pool
+    IdRegistry<TVersioned*> handles;  // id <-> dense handle -> attribute (nullptr once removed)
+    IStorageAdapter* storageAdapter;  // Storage adapter for persistence
+    const char* label;  // Used in error messages, e.g. "Objective"
+    const char* yamlType;  // Type tag written by toYAML()/exportToKG()
+
+    bool indexesEnabled = false;
+    mutable std::shared_mutex secondaryMutex;  // Guards the secondary and content indexes
+    SecondaryIndex<InternedString> authorIndex;  // Keyed by handle: equality is a pointer compare
+    SecondaryIndex<std::time_t> timestampIndex;
+    InvertedIndex* textIndex = nullptr;  // Not owned (shared by every agent of a manager)
+    CompletionIndex* completionIndex = nullptr;  // Not owned (shared by every agent of a manager)
+    Strand* strand = nullptr;  // Serialises the *Async operations; null runs them inline
+    // Published versions; empty while snapshot mode is off. The cell itself lives as long as the
+    // agent, so disableSnapshots() only publishes nullptr and readers pinned before keep their version
+    RcuCell<AttributeSnapshot> snapshots;
+    std::atomic<bool> snapshotMode{false};  // Written with every shard held, read under any of them
+    std::mutex columnMutex;  // Serialises columnar refreshes
+    std::shared_ptr<const ColumnarSnapshot> columns;  // Null while columnar tracking is off
+    std::atomic<bool> columnsTracked{false};
+    std::mutex dirtyMutex;  // Guards dirtyRows; taken inside a shard lock
+    std::vector<AttributeHandle> dirtyRows;  // Rows changed since `columns` was built
+
+    // Optional author: who made this change
+    static void applyAuthor(TVersioned* obj, std::string_view author) {
+        if (!author.empty()) {
+            obj->setAuthor(author);
+        }
+    }
+
+    // Caller holds secondaryMutex
+    void indexSecondaryLocked(const std::string& id, const TVersioned* obj) {
+        authorIndex.update(id, obj->getAuthorHandle());
+        timestampIndex.update(id, obj->getTimestamp());
+        indexContent(id, obj);
+    }
+
+    void indexSecondary(const std::string& id, const TVersioned* obj) {
+        std::unique_lock<std::shared_mutex> lock(secondaryMutex);
+        if (indexesEnabled) {
+            indexSecondaryLocked(id, obj);
+        }
+    }
+
+    void markColumnsDirty(const std::string& id) {
+        if (!columnsTracked.load()) {
+            return;
+        }
+        AttributeHandle handle = handles.find(id);
+        if (handle != INVALID_ATTRIBUTE_HANDLE) {
+            std::lock_guard<std::mutex> lock(dirtyMutex);
+            dirtyRows.push_back(handle);
+        }
+    }
+
+    // Caller holds the shard lock of `obj`
+    ColumnarRow columnarRow(const TVersioned* obj) const {
+        ColumnarRow row;
+        row.present = true;
+        row.id = obj->getID();
+        row.timestamp = obj->getTimestamp();
+        row.author = obj->getAuthorHandle();
+        row.title = completionTitle(obj);
+        fillColumnarRow(row, obj);
+        return row;
+    }
+
+    // Owner key in the indexes shared with the other agents of a manager: ids are unique per type only
+    static std::uint32_t indexOwner(const TVersioned* obj) {
+        return static_cast<std::uint32_t>(obj->getType());
+    }
+
+    void indexAttribute(const std::string& id, const TVersioned* obj) {
+        markColumnsDirty(id);
+        if (textIndex) {
+            textIndex->update(id, contentText(obj), indexOwner(obj));
+        }
+        if (completionIndex) {
+            completionIndex->update(id, completionTitle(obj), indexOwner(obj));
+        }
+        indexSecondary(id, obj);
+    }
+
+    void unindexAttribute(const std::string& id, const TVersioned* obj) {
+        markColumnsDirty(id);
+        if (textIndex) {
+            textIndex->remove(id, indexOwner(obj));
+        }
+        if (completionIndex) {
+            completionIndex->remove(id, indexOwner(obj));
+        }
+        std::unique_lock<std::shared_mutex> lock(secondaryMutex);
+        if (!indexesEnabled) {
+            return;
+        }
+        authorIndex.erase(id);
+        timestampIndex.erase(id);
+        unindexContent(id);
+    }
+
+    // Map adapter: typed params viewing the strings of `params`, plus the optional "author"
+    TParams typedParams(const std::map<std::string, std::string>& params) const {
+        TParams typed = parseParams(params);
+        auto author = params.find("author");
+        if (author != params.end()) {
+            typed.author = author->second;
+        }
+        return typed;
+    }
+
+    // Caller holds the shard lock of `id` (as do the helpers below)
+    TVersioned* findLocked(const std::string& id) const noexcept {
+        const auto& map = index.shardFor(id).map;
+        auto it = map.find(id);
+        return (it != map.end()) ? it->second : nullptr;
+    }
+
+    TVersioned* findOrThrowLocked(const std::string& id) const {
+        auto* obj = findLocked(id);
+        if (!obj) {
+            throw std::invalid_argument(std::string(label) + " not found: " + id);
+        }
+        return obj;
+    }
+
+    void requireFree(const std::string& id) const {
+        if (findLocked(id)) {
+            throw std::invalid_argument(std::string(label) + " ID already exists: " + id);
+        }
+    }
+
+    // In-memory part of a create; caller checked that `id` is free and persists afterwards
+    TVersioned* createNew(const std::string& id, const TParams& params) {
+        validateParams(params);
+        TVersioned* obj = emplaceLocked(id, TContent::FromParams(params));
+        applyAuthor(obj, params.author);
+        indexAttribute(id, obj);
+        return obj;
+    }
+
+    // In-memory part of an update; caller persists afterwards
+    void updateExisting(TVersioned* obj, const TParams& params) {
+        validateParams(params);
+        obj->updateContent(TContent::FromParams(params));
+        applyAuthor(obj, params.author);
+        indexAttribute(obj->getID(), obj);
+    }
+
+    void publish(const std::vector<std::pair<std::string, std::string>>& upserts,
+                 const std::vector<std::string>& removals = std::vector<std::string>()) {
+        if (snapshotMode) {
+            snapshots.update([&](const AttributeSnapshot* current) { return current->with(upserts, removals); });
+        }
+    }
+
+    // Take over the version `other` publishes (each cell stays with its agent); `other` ends with
+    // snapshot mode off
+    void adoptSnapshots(AttributeRepoAgent& other) {
+        AttributeSnapshotReader current = other.snapshots.read();
+        snapshots.publish(current ? new AttributeSnapshot(*current) : nullptr);
+        snapshotMode = other.snapshotMode.load();
+        other.snapshotMode = false;
+        other.snapshots.publish(nullptr);
+    }
+
+    // Publish and persist the state of `obj` (serialized once for both)
+    void persist(const TVersioned* obj) {
+        if (!storageAdapter && !snapshotMode) {
+            return;
+        }
+        std::string json = obj->toFullJSON();
+        publish({{obj->getID(), json}});
+        if (storageAdapter) {
+            storageAdapter->save(obj->getID(), json);  // Persist to storage
+        }
+    }
+
+    // Construct an attribute in the pool and index it
+    template <typename... Args>
+    TVersioned* emplaceLocked(Args&&... args) {
+        TVersioned* obj;
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            obj = pool.create(std::forward<Args>(args)..., versionStore);
+        }
+        try {
+            index.shardFor(obj->getID()).map.emplace(obj->getID(), obj);
+            try {
+                handles.assign(obj->getID(), obj);
+            } catch (...) {
+                index.shardFor(obj->getID()).map.erase(obj->getID());
+                throw;
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            pool.destroy(obj);
+            throw;
+        }
+        return obj;
+    }
+
+    // Caller holds the write lock of `id`, which is not in memory. Rebuild it from its stored
+    // record (toFullJSON() output); a record of another attribute type is rejected
+    TVersioned* hydrateLocked(const std::string& id, const std::string& json) {
+        auto record = JSONFields::readObject(json);
+        auto metadata = JSONFields::readObject(JSONFields::getString(record, "metadata"));
+        TVersioned* obj = emplaceLocked(id, TContent::FromJSON(JSONFields::getString(record, "content")));
+        if (static_cast<int>(obj->getType()) != JSONFields::getInt(metadata, "type")) {
+            index.shardFor(id).map.erase(id);
+            handles.assign(id, nullptr);
+            {
+                std::lock_guard<std::mutex> lock(poolMutex);
+                pool.destroy(obj);
+            }
+            throw std::invalid_argument(std::string(label) + ": stored record " + id + " is another attribute type");
+        }
+        // Keep the stored author/timestamp rather than the load time
+        auto author = metadata.find("author");
+        if (author != metadata.end()) {
+            obj->setAuthor(author->second);
+        }
+        auto timestamp = metadata.find("timestamp");
+        if (timestamp != metadata.end()) {
+            obj->setTimestamp(static_cast<std::time_t>(std::strtoll(timestamp->second.c_str(), nullptr, 10)));
+        }
+        auto history = metadata.find("history");
+        if (history != metadata.end()) {
+            obj->restoreHistory(ContentBlobStore::readRefList(history->second));  // Staged by loadHistory()
+        }
+        indexAttribute(id, obj);
+        if (snapshotMode) {
+            publish({{id, obj->toFullJSON()}});
+        }
+        return obj;
+    }
+
+    // Apply `apply` to every item, collect per-item failures, then persist the survivors with one
+    // saveBatch(). Items are (id, params) pairs; one failing item never stops the others.
+    // Every shard the batch touches stays write-locked (in shard order) until the write is done:
+    // each item is serialized right after it is applied, and no concurrent update/remove can slip
+    // in before publish()/saveBatch() and be overwritten by the batch's older state.
+    template <typename Item, typename Apply>
+    BatchResult runBatch(const std::vector<Item>& items, Apply apply) {
+        BatchResult result;
+        std::vector<std::string> ids;
+        ids.reserve(items.size());
+        for (const auto& item : items) {
+            ids.push_back(item.first);
+        }
+        auto lock = index.lockKeys(ids);
+        bool serialize = storageAdapter || snapshotMode;
+        std::vector<std::string> keys;
+        std::vector<std::string> values;
+        for (std::size_t i = 0; i < items.size(); ++i) {
+            try {
+                apply(items[i].first, items[i].second);
+                if (serialize) {
+                    values.push_back(findOrThrowLocked(items[i].first)->toFullJSON());
+                    keys.push_back(items[i].first);
+                }
+                result.succeeded += 1;
+            } catch (const std::exception& e) {
+                result.failures.push_back(BatchFailure{i, items[i].first, e.what()});
+            }
+        }
+        if (!keys.empty()) {
+            if (snapshotMode) {
+                std::vector<std::pair<std::string, std::string>> upserts;
+                upserts.reserve(keys.size());
+                for (std::size_t i = 0; i < keys.size(); ++i) {
+                    upserts.emplace_back(keys[i], values[i]);
+                }
+                publish(upserts);
+            }
+            if (storageAdapter) {
+                storageAdapter->saveBatch(keys, values);
+            }
+        }
+        return result;
+    }
+
+    void dispatch(std::function<void()> task) {
+        if (strand) {
+            strand->post(std::move(task));
+        } else {
+            task();
+        }
+    }
+
+    void reserveFor(std::size_t count) {
+        {
+            std::lock_guard<std::mutex> lock(poolMutex);
+            pool.reserve(count);
+        }
+        index.reserve(count);
+    }
+
+protected:
+    typedef std::map<std::string, std::string> Params;
+
+    AttributeRepoAgent(IStorageAdapter* adapter, const char* label, const char* yamlType)
+        : storageAdapter(adapter), label(label), yamlType(yamlType) {}
+
+    // Helper: Find attribute by ID (nullptr if absent). The lock is released on return, see the
+    // class comment
+    TVersioned* findById(const std::string& id) const noexcept {
+        auto lock = index.readLock(id);
+        return findLocked(id);
+    }
+
+    // Type-specific hooks
+    virtual TParams parseParams(const Params& params) const = 0;  // Presence and number/bool format
+    virtual void validateParams(const TParams& params) const = 0;  // Runs on both paths
+    virtual void writeYAMLContent(std::stringstream& yaml, const TVersioned* obj) const = 0;
+    virtual std::string contentText(const TVersioned* obj) const = 0;  // Searchable text fields
+    virtual std::string completionTitle(const TVersioned* obj) const { (void)obj; return ""; }  // "" = untitled
+
+    // Content-key index hooks (no-ops for agents without content indexes)
+    virtual void indexContent(const std::string& id, const TVersioned* obj) { (void)id; (void)obj; }
+    virtual void unindexContent(const std::string& id) { (void)id; }
+    virtual void clearContentIndexes() {}
+
+    // Columnar hook: type-specific columns (priority, status) of one row
+    virtual void fillColumnarRow(ColumnarRow& row, const TVersioned* obj) const { (void)row; (void)obj; }
+
+    // Map-path helper: the value of a required text param (a view into `params`)
+    static std::string_view textParam(const Params& params, const char* key) {
+        auto it = params.find(key);
+        if (it == params.end() || it->second.empty()) {
+            throw std::invalid_argument(std::string("Missing or empty ") + key);
+        }
+        return it->second;
+    }
+
+    // Typed-path counterpart of textParam(), same message
+    static void requireText(std::string_view value, const char* key) {
+        if (value.empty()) {
+            throw std::invalid_argument(std::string("Missing or empty ") + key);
+        }
+    }
+
+    void requireIndexes() const {
+        if (!indexesEnabled) {
+            throw std::runtime_error(std::string(label) + " secondary indexes are not enabled");
+        }
+    }
+
+public:
+    // Owners detach the executor first (see setExecutor), so no queued operation can run against a
+    // half-destroyed subclass. The version store goes as a whole: attributes skip their releases
+    ~AttributeRepoAgent() override {
+        delete strand;
+        if (versionStore) {
+            versionStore->beginTeardown();
+        }
+        pool.clear();
+        delete versionStore;
+    }
+
+    // No copy (to avoid double-delete)
+    AttributeRepoAgent(const AttributeRepoAgent&) = delete;
+    AttributeRepoAgent& operator=(const AttributeRepoAgent&) = delete;
+
+    // Move constructor/assignment (attributes stay in place, only the pool's slabs change hands).
+    // Queued async operations of `other` finish first; its strand then serves this agent
+    AttributeRepoAgent(AttributeRepoAgent&& other) noexcept
+        : versionStore(other.versionStore), pool((other.drainAsync(), std::move(other.pool))), index(std::move(other.index)), handles(std::move(other.handles)), storageAdapter(other.storageAdapter),
+          label(other.label), yamlType(other.yamlType), indexesEnabled(other.indexesEnabled),
+          authorIndex(std::move(other.authorIndex)), timestampIndex(std::move(other.timestampIndex)),
+          textIndex(other.textIndex), completionIndex(other.completionIndex), strand(other.strand),
+          columns(std::move(other.columns)), columnsTracked(other.columnsTracked.load()),
+          dirtyRows(std::move(other.dirtyRows)) {
+        other.columnsTracked = false;
+        other.versionStore = nullptr;  // Attributes it creates from now on use the shared store
+        other.strand = nullptr;
+        adoptSnapshots(other);
+        other.index.clear();
+        other.storageAdapter = nullptr;
+        other.indexesEnabled = false;
+        other.textIndex = nullptr;
+        other.completionIndex = nullptr;
+    }
+    AttributeRepoAgent& operator=(AttributeRepoAgent&& other) noexcept {
+        if (this != &other) {
+            drainAsync();
+            other.drainAsync();
+            delete strand;
+            strand = other.strand;
+            other.strand = nullptr;
+            adoptSnapshots(other);
+            columns = std::move(other.columns);
+            columnsTracked = other.columnsTracked.load();
+            other.columnsTracked = false;
+            dirtyRows = std::move(other.dirtyRows);
+            index.clear();
+            if (versionStore) {
+                versionStore->beginTeardown();
+            }
+            pool = std::move(other.pool);
+            delete versionStore;
+            versionStore = other.versionStore;
+            other.versionStore = nullptr;
+            index = std::move(other.index);
+            handles = std::move(other.handles);
+            storageAdapter = other.storageAdapter;
+            indexesEnabled = other.indexesEnabled;
+            authorIndex = std::move(other.authorIndex);
+            timestampIndex = std::move(other.timestampIndex);
+            textIndex = other.textIndex;
+            completionIndex = other.completionIndex;
+            other.index.clear();
+            other.storageAdapter = nullptr;
+            other.indexesEnabled = false;
+            other.textIndex = nullptr;
+            other.completionIndex = nullptr;
+        }
+        return *this;
+    }
+
+    // CRUD operations
+    void create(const std::string& id, const Params& params) override {
+        auto lock = index.writeLock(id);
+        requireFree(id);
+        persist(createNew(id, typedParams(params)));
+    }
+
+    void create(const std::string& id, const TParams& params) {
+        auto lock = index.writeLock(id);
+        requireFree(id);
+        persist(createNew(id, params));
+    }
+
+    void* read(const std::string& id) const override {
+        auto* obj = findById(id);
+        if (!obj && storageAdapter) {
+            // Read-through: only the in-memory copy catches up with storage, hence the const_cast
+            obj = const_cast<AttributeRepoAgent*>(this)->loadStored(id);
+        }
+        if (!obj) {
+            throw std::invalid_argument(std::string(label) + " not found: " + id);
+        }
+        return obj;  // Consumer casts to TVersioned*
+    }
+
+    // Hydrate `id` from storage as loadFromJSON() would; nullptr if it is not stored (or stored
+    // as another attribute type). The lookup runs under the write lock, so a concurrent remove()
+    // cannot be undone by a stale record
+    TVersioned* loadStored(const std::string& id) {
+        auto lock = index.writeLock(id);
+        if (TVersioned* obj = findLocked(id)) {
+            return obj;  // Created or loaded since the miss
+        }
+        std::string json = storageAdapter->load(id);
+        if (json.empty()) {
+            return nullptr;
+        }
+        try {
+            return hydrateLocked(id, json);
+        } catch (const std::invalid_argument&) {
+            return nullptr;
+        }
+    }
+
+    bool contains(const std::string& id) const noexcept override {
+        return findById(id) != nullptr;
+    }
+
+    // Run fn(const TVersioned&) with the attribute read-locked; false (fn not run) if absent.
+    // fn must not call back into this agent for an id of the same shard
+    template <typename Fn>
+    bool visit(const std::string& id, Fn fn) const {
+        auto lock = index.readLock(id);
+        const TVersioned* obj = findLocked(id);
+        if (!obj) {
+            return false;
+        }
+        fn(*obj);
+        return true;
+    }
+
+    void* tryRead(const std::string& id) const noexcept override {
+        return findById(id);
+    }
+
+    // Typed handle, nullptr if absent
+    TVersioned* find(const std::string& id) const noexcept {
+        return findById(id);
+    }
+
+    // Dense handles: a handle stays bound to its id for the agent's lifetime, and resolves to
+    // nothing while that id is absent
+    AttributeHandle handleOf(const std::string& id) const noexcept override {
+        AttributeHandle handle = handles.find(id);
+        return (handle != INVALID_ATTRIBUTE_HANDLE && handles.get(handle)) ? handle : INVALID_ATTRIBUTE_HANDLE;
+    }
+
+    const std::string& idOf(AttributeHandle handle) const override {
+        const std::string* id = handles.idOf(handle);
+        if (!id) {
+            throw std::invalid_argument(std::string(label) + " not found: handle " + std::to_string(handle));
+        }
+        return *id;
+    }
+
+    void* read(AttributeHandle handle) const override {
+        TVersioned* obj = handles.get(handle);
+        if (!obj) {
+            throw std::invalid_argument(std::string(label) + " not found: handle " + std::to_string(handle));
+        }
+        return obj;
+    }
+
+    void* tryRead(AttributeHandle handle) const noexcept override {
+        return handles.get(handle);
+    }
+
+    bool contains(AttributeHandle handle) const noexcept override {
+        return handles.get(handle) != nullptr;
+    }
+
+    TVersioned* find(AttributeHandle handle) const noexcept {
+        return handles.get(handle);
+    }
+
+    void update(AttributeHandle handle, const Params& params) override {
+        update(idOf(handle), params);
+    }
+
+    void update(AttributeHandle handle, const TParams& params) {
+        update(idOf(handle), params);
+    }
+
+    void remove(AttributeHandle handle) override {
+        remove(idOf(handle));
+    }
+
+    std::string toJSON(AttributeHandle handle) const override {
+        return toJSON(idOf(handle));
+    }
+
+    void update(const std::string& id, const Params& params) override {
+        auto lock = index.writeLock(id);
+        auto* obj = findOrThrowLocked(id);
+        updateExisting(obj, typedParams(params));
+        persist(obj);
+    }
+
+    void update(const std::string& id, const TParams& params) {
+        auto lock = index.writeLock(id);
+        auto* obj = findOrThrowLocked(id);
+        updateExisting(obj, params);
+        persist(obj);
+    }
+
+    // Bulk operations: same checks and messages as create()/update() per item, one saveBatch() overall
+    BatchResult createBatch(const AttributeBatch& items) override {
+        reserveFor(items.size());
+        return runBatch(items, [this](const std::string& id, const Params& params) {
+            requireFree(id);
+            createNew(id, typedParams(params));
+        });
+    }
+
+    BatchResult createBatch(const std::vector<std::pair<std::string, TParams>>& items) {
+        reserveFor(items.size());
+        return runBatch(items, [this](const std::string& id, const TParams& params) {
+            requireFree(id);
+            createNew(id, params);
+        });
+    }
+
+    BatchResult updateBatch(const AttributeBatch& items) override {
+        return runBatch(items, [this](const std::string& id, const Params& params) {
+            auto* obj = findOrThrowLocked(id);
+            updateExisting(obj, typedParams(params));
+        });
+    }
+
+    BatchResult updateBatch(const std::vector<std::pair<std::string, TParams>>& items) {
+        return runBatch(items, [this](const std::string& id, const TParams& params) {
+            updateExisting(findOrThrowLocked(id), params);
+        });
+    }
+
+    void remove(const std::string& id) override {
+        auto lock = index.writeLock(id);
+        auto& map = index.shardFor(id).map;
+        auto it = map.find(id);
+        if (it == map.end()) {
+            throw std::invalid_argument(std::string(label) + " not found: " + id);
+        }
+        TVersioned* obj = it->second;
+        map.erase(it);
+        handles.assign(id, nullptr);
+        unindexAttribute(id, obj);
+        {
+            std::lock_guard<std::mutex> poolLock(poolMutex);
+            pool.destroy(obj);
+        }
+        publish({}, {id});
+        if (storageAdapter) {
+            storageAdapter->remove(id);  // Remove from storage
+        }
+    }
+
+    // Serialization
+    std::string toJSON(const std::string& id) const override {
+        auto lock = index.readLock(id);
+        return findOrThrowLocked(id)->toFullJSON();
+    }
+
+    std::string toYAML(const std::string& id) const override {
+        auto lock = index.readLock(id);
+        auto* obj = findOrThrowLocked(id);
+        std::stringstream yaml;
+        yaml << "id: " << id << "\n";
+        yaml << "type: " << yamlType << "\n";
+        yaml << "content:\n";
+        writeYAMLContent(yaml, obj);
+        yaml << "relations:\n";
+        for (const auto& rel : obj->getRelations()) {
+            yaml << "  - " << static_cast<int>(rel) << "\n";
+        }
+        return yaml.str();
+    }
+
+    // KG export
+    void exportToKG(const std::string& id) const override {
+        auto lock = index.readLock(id);
+        findOrThrowLocked(id);
+        // Pseudo-code: Export node and edges to KG
+        // KGClient::createNode(id, yamlType, toJSON(id));
+        // for (rel : obj->getRelations()) KGClient::createEdge(id, rel.target, rel.type);
+    }
+
+    // Async communication (arguments are copied into the queued operation)
+    void createAsync(const std::string& id, const Params& params,
+                     std::function<void(const std::string&, bool)> callback) override {
+        dispatch([this, id, params, callback] {
+            bool ok = true;
+            try {
+                create(id, params);
+            } catch (const std::exception&) {
+                ok = false;
+            }
+            callback(id, ok);
+        });
+    }
+
+    void updateAsync(const std::string& id, const Params& params,
+                     std::function<void(const std::string&, bool)> callback) override {
+        dispatch([this, id, params, callback] {
+            bool ok = true;
+            try {
+                update(id, params);
+            } catch (const std::exception&) {
+                ok = false;
+            }
+            callback(id, ok);
+        });
+    }
+
+    void removeAsync(const std::string& id, std::function<void(const std::string&, bool)> callback) override {
+        dispatch([this, id, callback] {
+            bool ok = true;
+            try {
+                remove(id);
+            } catch (const std::exception&) {
+                ok = false;
+            }
+            callback(id, ok);
+        });
+    }
+
+    void readAsync(const std::string& id,
+                   std::function<void(const std::string&, bool, const std::string&)> callback) override {
+        dispatch([this, id, callback] {
+            std::string json;
+            bool found = visit(id, [&json](const TVersioned& obj) { json = obj.toFullJSON(); });
+            callback(id, found, json);
+        });
+    }
+
+    void setExecutor(WorkStealingExecutor* executor) override {
+        drainAsync();
+        delete strand;
+        strand = executor ? new Strand(*executor) : nullptr;
+    }
+
+    void drainAsync() override {
+        if (strand) {
+            strand->waitIdle();
+        }
+    }
+
+    // Bulk persistence support (ids in pool slot order)
+    std::vector<std::string> listIDs() const override {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        std::vector<std::string> ids;
+        ids.reserve(pool.size());
+        pool.forEach([&ids](const TVersioned* obj) { ids.push_back(obj->getID()); });
+        return ids;
+    }
+
+    void loadFromJSON(const std::string& id, const std::string& json) override {
+        auto lock = index.writeLock(id);
+        if (findLocked(id)) {
+            return;  // In-memory state is authoritative (every edit is persisted)
+        }
+        hydrateLocked(id, json);
+    }
+
+    // Version history persistence (a moved-from agent has no store of its own)
+    void persistHistory(IStorageAdapter& adapter, const std::string& keyPrefix) override {
+        if (versionStore) {
+            versionStore->persist(adapter, keyPrefix);
+        }
+    }
+
+    void loadHistory(IStorageAdapter& adapter, const std::string& keyPrefix) override {
+        if (versionStore) {
+            versionStore->load(adapter, keyPrefix);
+        }
+    }
+
+    void pruneHistory(IStorageAdapter& adapter, const std::string& keyPrefix) override {
+        if (versionStore) {
+            versionStore->prune(adapter, keyPrefix);
+        }
+    }
+
+    // Storage adapter management
+    void setStorageAdapter(IStorageAdapter* adapter) override {
+        storageAdapter = adapter;
+    }
+
+    std::size_t size() const { return index.size(); }  // Sums the shards; a snapshot under writes
+
+    // Full-text index management: the old index forgets this agent's attributes, the new one learns them
+    void setFullTextIndex(InvertedIndex* newIndex) override {
+        auto lock = index.lockAll();
+        if (textIndex) {
+            index.forEachLocked([this](const std::string& id, TVersioned* obj) { textIndex->remove(id, indexOwner(obj)); });
+        }
+        textIndex = newIndex;
+        if (textIndex) {
+            std::lock_guard<std::mutex> poolLock(poolMutex);
+            pool.forEach([this](const TVersioned* obj) { textIndex->update(obj->getID(), contentText(obj), indexOwner(obj)); });
+        }
+    }
+
+    // Autocomplete index management, same hand-over as setFullTextIndex()
+    void setCompletionIndex(CompletionIndex* newIndex) override {
+        auto lock = index.lockAll();
+        if (completionIndex) {
+            index.forEachLocked([this](const std::string& id, TVersioned* obj) { completionIndex->remove(id, indexOwner(obj)); });
+        }
+        completionIndex = newIndex;
+        if (completionIndex) {
+            std::lock_guard<std::mutex> poolLock(poolMutex);
+            pool.forEach([this](const TVersioned* obj) {
+                completionIndex->update(obj->getID(), completionTitle(obj), indexOwner(obj));
+            });
+        }
+    }
+
+    // Snapshot mode
+    void enableSnapshots() override {
+        auto lock = index.lockAll();
+        if (snapshotMode) {
+            return;
+        }
+        std::vector<std::pair<std::string, std::string>> records;
+        {
+            std::lock_guard<std::mutex> poolLock(poolMutex);
+            records.reserve(pool.size());
+            pool.forEach([&records](const TVersioned* obj) { records.emplace_back(obj->getID(), obj->toFullJSON()); });
+        }
+        snapshots.publish(AttributeSnapshot().with(records));
+        snapshotMode = true;
+    }
+
+    // Retires the current version through the cell's epochs, so a concurrent snapshot() never sees
+    // it freed and readers taken before keep it until they are dropped
+    void disableSnapshots() override {
+        auto lock = index.lockAll();
+        snapshotMode = false;
+        snapshots.publish(nullptr);
+    }
+
+    // Current version of every record, valid for as long as the reader lives. Lock-free: the
+    // cell's pointer is atomic and the cell outlives every enable/disable
+    AttributeSnapshotReader snapshot() const override {
+        return snapshots.read();
+    }
+
+    // Columnar snapshot. The first build takes every shard; a refresh only reads the changed rows,
+    // each under its own shard lock
+    std::shared_ptr<const ColumnarSnapshot> columnarSnapshot() override {
+        std::lock_guard<std::mutex> lock(columnMutex);
+        std::vector<std::pair<AttributeHandle, ColumnarRow>> changes;
+        if (!columns) {
+            auto all = index.lockAll();
+            {
+                std::lock_guard<std::mutex> dirtyLock(dirtyMutex);
+                dirtyRows.clear();
+            }
+            columnsTracked = true;
+            std::size_t rowCount = handles.size();
+            changes.resize(rowCount);
+            for (AttributeHandle handle = 0; handle < rowCount; ++handle) {
+                changes[handle].first = handle;
+                changes[handle].second.id = *handles.idOf(handle);  // Removed rows keep their id
+            }
+            index.forEachLocked([this, &changes](const std::string& id, TVersioned* obj) {
+                changes[handles.find(id)].second = columnarRow(obj);
+            });
+            columns.reset(ColumnarSnapshot().patched(rowCount, changes));
+            return columns;
+        }
+        std::vector<AttributeHandle> rows;
+        {
+            std::lock_guard<std::mutex> dirtyLock(dirtyMutex);
+            rows.swap(dirtyRows);
+        }
+        if (rows.empty()) {
+            return columns;
+        }
+        std::sort(rows.begin(), rows.end());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+        std::size_t rowCount = handles.size();  // Covers every handle in `rows`
+        changes.reserve(rows.size());
+        for (AttributeHandle handle : rows) {
+            const std::string& id = *handles.idOf(handle);
+            ColumnarRow row;
+            if (!visit(id, [this, &row](const TVersioned& obj) { row = columnarRow(&obj); })) {
+                row.id = id;  // Removed: the row keeps its id, present = false
+            }
+            changes.emplace_back(handle, std::move(row));
+        }
+        columns.reset(columns->patched(rowCount, changes));
+        return columns;
+    }
+
+    void disableColumnarSnapshot() override {
+        std::lock_guard<std::mutex> lock(columnMutex);
+        columnsTracked = false;
+        columns.reset();
+        std::lock_guard<std::mutex> dirtyLock(dirtyMutex);
+        dirtyRows.clear();
+    }
+
+    // Secondary indexes
+    void enableSecondaryIndexes() {
+        auto lock = index.lockAll();
+        std::unique_lock<std::shared_mutex> secondaryLock(secondaryMutex);
+        if (indexesEnabled) {
+            return;
+        }
+        indexesEnabled = true;
+        std::lock_guard<std::mutex> poolLock(poolMutex);
+        pool.forEach([this](const TVersioned* obj) { indexSecondaryLocked(obj->getID(), obj); });
+    }
+
+    void disableSecondaryIndexes() {
+        std::unique_lock<std::shared_mutex> lock(secondaryMutex);
+        indexesEnabled = false;
+        authorIndex.clear();
+        timestampIndex.clear();
+        clearContentIndexes();
+    }
+
+    bool secondaryIndexesEnabled() const {
+        std::shared_lock<std::shared_mutex> lock(secondaryMutex);
+        return indexesEnabled;
+    }
+
+    // Run fn() with the secondary indexes read-locked. The Ranges returned by the find* queries
+    // below are invalidated by any write, so concurrent callers query and walk them inside fn
+    template <typename Fn>
+    void readSecondaryIndexes(Fn fn) const {
+        std::shared_lock<std::shared_mutex> lock(secondaryMutex);
+        fn();
+    }
+
+    // Ids last changed by `author`
+    typename SecondaryIndex<InternedString>::Range findByAuthor(const std::string& author) const {
+        requireIndexes();
+        std::optional<InternedString> key = InternedString::lookup(author);
+        return key ? authorIndex.equalRange(*key) : authorIndex.none();
+    }
+
+    // Ids last changed in [from, to], oldest first
+    typename SecondaryIndex<std::time_t>::Range findByTimestamp(std::time_t from, std::time_t to) const {
+        requireIndexes();
+        return timestampIndex.range(from, to);
+    }
+};
+
+
+
+
+#endif // __ATTRIBUTEREPOAGENT_HPP__
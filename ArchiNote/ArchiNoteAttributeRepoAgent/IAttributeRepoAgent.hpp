@@ -6,9 +6,18 @@
 #include <map>
 #include <vector>
 #include <functional>
+#include <memory>
 #include <stdexcept>
 
-#include "../../ArchiNoteStorage/IStorageAdapter.hpp"
+#include "../ArchiNoteStorage/IStorageAdapter.hpp"
+#include "../Structs/BatchResult.hpp"
+#include "../ArchiNoteConcurrency/AttributeSnapshot.hpp"
+#include "../ArchiNoteIndex/IdRegistry.hpp"
+#include "../ArchiNoteAnalytics/ColumnarSnapshot.hpp"
+
+class InvertedIndex;
+class CompletionIndex;
+class WorkStealingExecutor;
 
 
 // Interface for Attribute Repo Agent (generic CRUD + communication)
@@ -22,16 +31,74 @@ public:
     virtual void update(const std::string& id, const std::map<std::string, std::string>& params) = 0;
     virtual void remove(const std::string& id) = 0;
 
+    // Bulk create/update: every item is tried, failures are reported per item instead of thrown,
+    // and the applied items are persisted with a single storage write
+    virtual BatchResult createBatch(const AttributeBatch& items) = 0;
+    virtual BatchResult updateBatch(const AttributeBatch& items) = 0;
+
+    // Non-throwing lookups for hot paths (relation validation): in-memory only, a miss is nullptr/false
+    virtual bool contains(const std::string& id) const noexcept = 0;
+    virtual void* tryRead(const std::string& id) const noexcept = 0;  // Same handle as read(), or nullptr
+
+    // Dense handles (see IdRegistry): resolve an id once, then skip string hashing and compares.
+    // Reads by handle are an array index; writes resolve the id and lock it as usual
+    virtual AttributeHandle handleOf(const std::string& id) const noexcept = 0;  // INVALID_ATTRIBUTE_HANDLE if absent
+    virtual const std::string& idOf(AttributeHandle handle) const = 0;
+    virtual void* read(AttributeHandle handle) const = 0;
+    virtual void* tryRead(AttributeHandle handle) const noexcept = 0;
+    virtual bool contains(AttributeHandle handle) const noexcept = 0;
+    virtual void update(AttributeHandle handle, const std::map<std::string, std::string>& params) = 0;
+    virtual void remove(AttributeHandle handle) = 0;
+    virtual std::string toJSON(AttributeHandle handle) const = 0;
+
     // Serialization
     virtual std::string toJSON(const std::string& id) const = 0;
     virtual std::string toYAML(const std::string& id) const = 0;  // For ArchiGraph export
     virtual void exportToKG(const std::string& id) const = 0;  // To ArchiGraph nodes/edges
 
     // Async communication (optional, for frontend)
+    // With an executor attached these return at once; the operations of one agent run in submission
+    // order on an executor thread, which also invokes the callback. Without one they run inline.
     virtual void createAsync(const std::string& id, const std::map<std::string, std::string>& params, 
                             std::function<void(const std::string&, bool)> callback) = 0;
+    virtual void updateAsync(const std::string& id, const std::map<std::string, std::string>& params,
+                             std::function<void(const std::string&, bool)> callback) = 0;
+    virtual void removeAsync(const std::string& id, std::function<void(const std::string&, bool)> callback) = 0;
+    // Callback gets (id, found, toJSON() of the attribute or "")
+    virtual void readAsync(const std::string& id,
+                           std::function<void(const std::string&, bool, const std::string&)> callback) = 0;
+    // Attach the executor for the *Async operations (nullptr detaches, after the queued ones finished)
+    virtual void setExecutor(WorkStealingExecutor* executor) = 0;
+    // Block until every queued async operation has run. Must not be called from a callback
+    virtual void drainAsync() = 0;
    // set storage:
    virtual void setStorageAdapter(IStorageAdapter* adapter) = 0;
+
+    // Bulk persistence (used by the manager's saveAll/loadAll)
+    virtual std::vector<std::string> listIDs() const = 0;
+    virtual void loadFromJSON(const std::string& id, const std::string& json) = 0;  // Hydrate from toJSON() output
+    // Version history blobs, stored under `keyPrefix`: persistHistory() writes the ones not yet
+    // stored, loadHistory() stages the stored ones before loadFromJSON() adopts them, and
+    // pruneHistory() drops (and deletes) the staged blobs no loaded record referenced
+    virtual void persistHistory(IStorageAdapter& adapter, const std::string& keyPrefix) = 0;
+    virtual void loadHistory(IStorageAdapter& adapter, const std::string& keyPrefix) = 0;
+    virtual void pruneHistory(IStorageAdapter& adapter, const std::string& keyPrefix) = 0;
+
+    // Full-text search: feed the text fields of every attribute into `index` (nullptr detaches)
+    virtual void setFullTextIndex(InvertedIndex* index) = 0;
+    // Autocomplete: register every id (and title, for titled attributes) in `index` (nullptr detaches)
+    virtual void setCompletionIndex(CompletionIndex* index) = 0;
+
+    // Snapshot mode: every write also publishes an immutable version of all records, which
+    // snapshot() pins without taking a lock. Off by default (it serializes each edit once more)
+    virtual void enableSnapshots() = 0;
+    virtual void disableSnapshots() = 0;  // Readers already taken keep their version
+    virtual AttributeSnapshotReader snapshot() const = 0;  // Empty while disabled
+
+    // Columnar snapshot for analytics scans: the first call builds it, later calls patch in what
+    // changed since. Returned snapshots are immutable and outlive any later refresh
+    virtual std::shared_ptr<const ColumnarSnapshot> columnarSnapshot() = 0;
+    virtual void disableColumnarSnapshot() = 0;  // Stops tracking changes; drops the current snapshot
 };
 
 
@@ -17,7 +17,7 @@
 #include <algorithm>
 
 
-#include "../IAttributeRepoAgent.hpp"
+#include "../AttributeRepoAgent.hpp"
 #include "../../ArchiNoteAttribute/ProjectBriefAttributes/VersionedHighLevelFeature.hpp"
 #include "../../ArchiNoteStorage/IStorageAdapter.hpp"
 
@@ -25,187 +25,80 @@
 // Specialized Repo Agent for High-Level Features
 
 // Specialized Repo Agent for High-Level Features
-class HighLevelFeaturesRepoAgent : public IAttributeRepoAgent {
+class HighLevelFeaturesRepoAgent : public AttributeRepoAgent<VersionedHighLevelFeature, HighLevelFeatureContent, HighLevelFeatureParams> {
 private:
-    std::vector<VersionedHighLevelFeature*> features;  // In-memory storage
-    IStorageAdapter* storageAdapter;  // Storage adapter for persistence
-
-    // Helper: Find high-level feature by ID
-    VersionedHighLevelFeature* findById(const std::string& id) const {
-        auto it = std::find_if(features.begin(), features.end(),
-                               [&id](const VersionedHighLevelFeature* feature) { return feature->getID() == id; });
-        return (it != features.end()) ? *it : nullptr;
-    }
-
-    // Helper: Validate params map
-    void validateParams(const std::map<std::string, std::string>& params) const {
-        if (params.find("feature") == params.end() || params.at("feature").empty()) {
-            throw std::invalid_argument("Missing or empty feature");
-        }
-        if (params.find("description") == params.end() || params.at("description").empty()) {
-            throw std::invalid_argument("Missing or empty description");
-        }
-        if (params.find("priority") == params.end() || params.at("priority").empty()) {
-            throw std::invalid_argument("Missing or empty priority");
-        }
-        // Validate that priority is a valid integer and within range [1, 3]
+    SecondaryIndex<int> priorityIndex;  // Filled while secondary indexes are enabled
+
+    HighLevelFeatureParams parseParams(const Params& params) const override {
+        HighLevelFeatureParams typed;
+        typed.feature = textParam(params, "feature");
+        typed.description = textParam(params, "description");
+        std::string_view priority = textParam(params, "priority");
+        // Validate that priority is a valid integer (the range is checked by validateParams)
         try {
-            int priority = std::stoi(params.at("priority"));
-            if (priority < 1 || priority > 3) {
-                throw std::invalid_argument("Priority must be between 1 and 3");
-            }
+            typed.priority = std::stoi(std::string(priority));
         } catch (const std::exception&) {
             throw std::invalid_argument("Priority must be a valid integer");
         }
+        return typed;
     }
 
-public:
-    // Constructor with IStorageAdapter
-    HighLevelFeaturesRepoAgent(IStorageAdapter* adapter = nullptr) : storageAdapter(adapter) {}
-
-    ~HighLevelFeaturesRepoAgent() override {
-        for (auto* feature : features) {
-            delete feature;  // Manual memory management
+    void validateParams(const HighLevelFeatureParams& params) const override {
+        requireText(params.feature, "feature");
+        requireText(params.description, "description");
+        if (params.priority < 1 || params.priority > 3) {
+            throw std::invalid_argument("Priority must be between 1 and 3");
         }
-        features.clear();
     }
 
-    // No copy (to avoid double-delete)
-    HighLevelFeaturesRepoAgent(const HighLevelFeaturesRepoAgent&) = delete;
-    HighLevelFeaturesRepoAgent& operator=(const HighLevelFeaturesRepoAgent&) = delete;
-
-    // Move constructor/assignment
-    HighLevelFeaturesRepoAgent(HighLevelFeaturesRepoAgent&& other) noexcept 
-        : features(std::move(other.features)), storageAdapter(other.storageAdapter) {
-        other.features.clear();
-        other.storageAdapter = nullptr;
-    }
-    HighLevelFeaturesRepoAgent& operator=(HighLevelFeaturesRepoAgent&& other) noexcept {
-        if (this != &other) {
-            for (auto* feature : features) {
-                delete feature;
-            }
-            features.clear();
-            features = std::move(other.features);
-            storageAdapter = other.storageAdapter;
-            other.features.clear();
-            other.storageAdapter = nullptr;
-        }
-        return *this;
+    void writeYAMLContent(std::stringstream& yaml, const VersionedHighLevelFeature* feature) const override {
+        yaml << "  feature: \"" << feature->toFullJSON() /* simplified: extract feature */ << "\"\n";
+        yaml << "  description: \"" << feature->toFullJSON() /* simplified: extract description */ << "\"\n";
+        yaml << "  priority: " << feature->toFullJSON() /* simplified: extract priority */ << "\n";
     }
 
-    // CRUD operations
-    void create(const std::string& id, const std::map<std::string, std::string>& params) override {
-        if (findById(id)) {
-            throw std::invalid_argument("High-Level Feature ID already exists: " + id);
-        }
-        validateParams(params);
-        int priority = std::stoi(params.at("priority"));  // Convert string to int
-        auto* feature = new VersionedHighLevelFeature(id, params.at("feature"),
-                                                     params.at("description"),
-                                                     priority);
-        features.push_back(feature);
-        if (storageAdapter) {
-            storageAdapter->save(id, toJSON(id));  // Persist to storage
-        }
+    std::string contentText(const VersionedHighLevelFeature* feature) const override {
+        const auto& content = feature->getContent();
+        return content.feature + "\n" + content.description;
     }
 
-    void* read(const std::string& id) const override {
-        auto* feature = findById(id);
-        if (!feature && storageAdapter) {
-            // Try loading from storage
-            std::string data = storageAdapter->load(id);
-            if (!data.empty()) {
-                // Pseudo-code: Deserialize and add to features
-                // features.push_back(deserialize(data));
-                // feature = findById(id);
-            }
-        }
-        if (!feature) {
-            throw std::invalid_argument("High-Level Feature not found: " + id);
-        }
-        return feature;  // Consumer casts to VersionedHighLevelFeature*
+    std::string completionTitle(const VersionedHighLevelFeature* feature) const override {
+        return feature->getContent().feature;
     }
 
-    void update(const std::string& id, const std::map<std::string, std::string>& params) override {
-        auto* feature = findById(id);
-        if (!feature) {
-            throw std::invalid_argument("High-Level Feature not found: " + id);
-        }
-        validateParams(params);
-        int priority = std::stoi(params.at("priority"));  // Convert string to int
-        feature->updateContent(params.at("feature"), params.at("description"), priority);
-        if (storageAdapter) {
-            storageAdapter->save(id, toJSON(id));  // Persist to storage
-        }
+    void indexContent(const std::string& id, const VersionedHighLevelFeature* obj) override {
+        priorityIndex.update(id, obj->getContent().priority);
     }
 
-    void remove(const std::string& id) override {
-        auto it = std::find_if(features.begin(), features.end(),
-                               [&id](const VersionedHighLevelFeature* feature) { return feature->getID() == id; });
-        if (it == features.end()) {
-            throw std::invalid_argument("High-Level Feature not found: " + id);
-        }
-        delete *it;
-        features.erase(it);
-        if (storageAdapter) {
-            storageAdapter->remove(id);  // Remove from storage
-        }
+    void unindexContent(const std::string& id) override {
+        priorityIndex.erase(id);
     }
 
-    // Serialization
-    std::string toJSON(const std::string& id) const override {
-        auto* feature = findById(id);
-        if (!feature) {
-            throw std::invalid_argument("High-Level Feature not found: " + id);
-        }
-        return feature->toFullJSON();
+    void clearContentIndexes() override {
+        priorityIndex.clear();
     }
 
-    std::string toYAML(const std::string& id) const override {
-        auto* feature = findById(id);
-        if (!feature) {
-            throw std::invalid_argument("High-Level Feature not found: " + id);
-        }
-        std::stringstream yaml;
-        yaml << "id: " << id << "\n";
-        yaml << "type: HIGH_LEVEL_FEATURES\n";
-        yaml << "content:\n";
-        yaml << "  feature: \"" << feature->toFullJSON() /* simplified: extract feature */ << "\"\n";
-        yaml << "  description: \"" << feature->toFullJSON() /* simplified: extract description */ << "\"\n";
-        yaml << "  priority: " << feature->toFullJSON() /* simplified: extract priority */ << "\n";
-        yaml << "relations:\n";
-        for (const auto& rel : feature->getRelations()) {
-            yaml << "  - " << static_cast<int>(rel) << "\n";
-        }
-        return yaml.str();
+    void fillColumnarRow(ColumnarRow& row, const VersionedHighLevelFeature* obj) const override {
+        row.priority = obj->getContent().priority;
+        row.description = obj->getContent().description;
     }
 
-    // KG export
-    void exportToKG(const std::string& id) const override {
-        auto* feature = findById(id);
-        if (!feature) {
-            throw std::invalid_argument("High-Level Feature not found: " + id);
-        }
-        // Pseudo-code: Export node and edges to KG
-        // KGClient::createNode(id, "HIGH_LEVEL_FEATURES", toJSON(id));
-        // for (rel : feature->getRelations()) KGClient::createEdge(id, rel.target, rel.type);
-    }
+public:
+    HighLevelFeaturesRepoAgent(IStorageAdapter* adapter = nullptr)
+        : AttributeRepoAgent<VersionedHighLevelFeature, HighLevelFeatureContent, HighLevelFeatureParams>(adapter, "High-Level Feature", "HIGH_LEVEL_FEATURES") {}
 
-    // Async communication
-    void createAsync(const std::string& id, const std::map<std::string, std::string>& params, 
-                     std::function<void(const std::string&, bool)> callback) override {
-        try {
-            create(id, params);
-            callback(id, true);  // Success
-        } catch (const std::exception& e) {
-            callback(id, false);  // Failure
-        }
-    }
+    // No copy (to avoid double-delete)
+    HighLevelFeaturesRepoAgent(const HighLevelFeaturesRepoAgent&) = delete;
+    HighLevelFeaturesRepoAgent& operator=(const HighLevelFeaturesRepoAgent&) = delete;
+
+    // Move constructor/assignment
+    HighLevelFeaturesRepoAgent(HighLevelFeaturesRepoAgent&& other) noexcept = default;
+    HighLevelFeaturesRepoAgent& operator=(HighLevelFeaturesRepoAgent&& other) noexcept = default;
 
-    // Storage adapter management
-    void setStorageAdapter(IStorageAdapter* adapter) override {
-        storageAdapter = adapter;
+    // Ids with this priority (1..3); requires enableSecondaryIndexes()
+    SecondaryIndex<int>::Range findByPriority(int priority) const {
+        requireIndexes();
+        return priorityIndex.equalRange(priority);
     }
 };
 
@@ -6,7 +6,7 @@
 
 #include <algorithm>
 
-#include "../IAttributeRepoAgent.hpp"
+#include "../AttributeRepoAgent.hpp"
 #include "../../ArchiNoteAttribute/ProjectBriefAttributes/VersionedKeyObjective.hpp"
 #include "../../ArchiNoteStorage/IStorageAdapter.hpp"
 
@@ -70,186 +70,78 @@ public:
 */
 
 
-class ObjectivesRepoAgent : public IAttributeRepoAgent {
+class ObjectivesRepoAgent : public AttributeRepoAgent<VersionedKeyObjective, ObjectiveContent, ObjectiveParams> {
 private:
-    std::vector<VersionedKeyObjective*> objectives;  // In-memory storage
-    IStorageAdapter* storageAdapter;  // Storage adapter for persistence
-    // Helper: Find objective by ID
-    
-    VersionedKeyObjective* findById(const std::string& id) const {
-        auto it = std::find_if(objectives.begin(), objectives.end(),
-                               [&id](const VersionedKeyObjective* obj) { return obj->getID() == id; });
-        return (it != objectives.end()) ? *it : nullptr;
-    }
-    // Helper: Validate params map
-    
-
-    void validateParams(const std::map<std::string, std::string>& params) const {
-        if (params.find("description") == params.end() || params.at("description").empty()) {
-            throw std::invalid_argument("Missing or empty description");
-        }
-        if (params.find("metric") == params.end() || params.at("metric").empty()) {
-            throw std::invalid_argument("Missing or empty metric");
-        }
-        if (params.find("priority") == params.end()) {
+    SecondaryIndex<int> priorityIndex;  // Filled while secondary indexes are enabled
+
+    ObjectiveParams parseParams(const Params& params) const override {
+        ObjectiveParams typed;
+        typed.description = textParam(params, "description");
+        typed.metric = textParam(params, "metric");
+        auto priority = params.find("priority");
+        if (priority == params.end()) {
             throw std::invalid_argument("Missing priority");
         }
         try {
-            int priority = std::stoi(params.at("priority"));
-            if (priority < 1 || priority > 3) {
-                throw std::invalid_argument("Priority must be between 1 and 3");
-            }
+            typed.priority = std::stoi(priority->second);
         } catch (const std::exception&) {
             throw std::invalid_argument("Invalid priority format");
         }
+        return typed;
     }
 
-
-
-public:
-    ObjectivesRepoAgent(IStorageAdapter* adapter = nullptr) : storageAdapter(adapter) {}
-
-    ~ObjectivesRepoAgent() override {
-        for (auto* obj : objectives) {
-            delete obj;  // Manual memory management
+    void validateParams(const ObjectiveParams& params) const override {
+        requireText(params.description, "description");
+        requireText(params.metric, "metric");
+        if (params.priority < 1 || params.priority > 3) {
+            throw std::invalid_argument("Priority must be between 1 and 3");
         }
-        objectives.clear();
     }
-   
-    // No copy (to avoid double-delete)
-    ObjectivesRepoAgent(const ObjectivesRepoAgent&) = delete;
-    ObjectivesRepoAgent& operator=(const ObjectivesRepoAgent&) = delete;
 
-    // Move constructor/assignment
-    ObjectivesRepoAgent(ObjectivesRepoAgent&& other) noexcept 
-        : objectives(std::move(other.objectives)), storageAdapter(other.storageAdapter) {
-        other.objectives.clear();
-        other.storageAdapter = nullptr;
-    }
-    ObjectivesRepoAgent& operator=(ObjectivesRepoAgent&& other) noexcept {
-        if (this != &other) {
-            for (auto* obj : objectives) {
-                delete obj;
-            }
-            objectives.clear();
-            objectives = std::move(other.objectives);
-            storageAdapter = other.storageAdapter;
-            other.objectives.clear();
-            other.storageAdapter = nullptr;
-        }
-        return *this;
+    void writeYAMLContent(std::stringstream& yaml, const VersionedKeyObjective* obj) const override {
+        yaml << "  description: \"" << obj->toFullJSON() /* simplified: extract description */ << "\"\n";
+        yaml << "  metric: \"" << obj->toFullJSON() /* simplified: extract metric */ << "\"\n";
+        yaml << "  priority: " << obj->toFullJSON() /* simplified: extract priority */ << "\n";
     }
 
-    // CRUD operations
-    void create(const std::string& id, const std::map<std::string, std::string>& params) override {
-        if (findById(id)) {
-            throw std::invalid_argument("Objective ID already exists: " + id);
-        }
-        validateParams(params);
-        auto* objective = new VersionedKeyObjective(id, params.at("description"), 
-                                                   params.at("metric"), 
-                                                   std::stoi(params.at("priority")));
-        objectives.push_back(objective);
-        if (storageAdapter) {
-            storageAdapter->save(id, toJSON(id));  // Persist to storage
-        }
+    std::string contentText(const VersionedKeyObjective* obj) const override {
+        const auto& content = obj->getContent();
+        return content.description + "\n" + content.metric;
     }
 
-    void* read(const std::string& id) const override {
-        auto* obj = findById(id);
-        if (!obj && storageAdapter) {
-            // Try loading from storage
-            std::string data = storageAdapter->load(id);
-            if (!data.empty()) {
-                // Pseudo-code: Deserialize and add to objectives
-                // objectives.push_back(deserialize(data));
-                // obj = findById(id);
-            }
-        }
-        if (!obj) {
-            throw std::invalid_argument("Objective not found: " + id);
-        }
-        return obj;  // Consumer casts to VersionedKeyObjective*
+    void indexContent(const std::string& id, const VersionedKeyObjective* obj) override {
+        priorityIndex.update(id, obj->getContent().priority);
     }
 
-    void update(const std::string& id, const std::map<std::string, std::string>& params) override {
-        auto* obj = findById(id);
-        if (!obj) {
-            throw std::invalid_argument("Objective not found: " + id);
-        }
-        validateParams(params);
-        obj->updateContent(params.at("description"), params.at("metric"), std::stoi(params.at("priority")));
-        if (storageAdapter) {
-            storageAdapter->save(id, toJSON(id));  // Persist to storage
-        }
+    void unindexContent(const std::string& id) override {
+        priorityIndex.erase(id);
     }
 
-    void remove(const std::string& id) override {
-        auto it = std::find_if(objectives.begin(), objectives.end(),
-                               [&id](const VersionedKeyObjective* obj) { return obj->getID() == id; });
-        if (it == objectives.end()) {
-            throw std::invalid_argument("Objective not found: " + id);
-        }
-        delete *it;
-        objectives.erase(it);
-        if (storageAdapter) {
-            storageAdapter->remove(id);  // Remove from storage
-        }
+    void clearContentIndexes() override {
+        priorityIndex.clear();
     }
 
-    // Serialization
-    std::string toJSON(const std::string& id) const override {
-        auto* obj = findById(id);
-        if (!obj) {
-            throw std::invalid_argument("Objective not found: " + id);
-        }
-        return obj->toFullJSON();
+    void fillColumnarRow(ColumnarRow& row, const VersionedKeyObjective* obj) const override {
+        row.priority = obj->getContent().priority;
+        row.description = obj->getContent().description;
     }
 
-    std::string toYAML(const std::string& id) const override {
-        auto* obj = findById(id);
-        if (!obj) {
-            throw std::invalid_argument("Objective not found: " + id);
-        }
-        std::stringstream yaml;
-        yaml << "id: " << id << "\n";
-        yaml << "type: KEY_OBJECTIVES\n";
-        yaml << "content:\n";
-        yaml << "  description: \"" << obj->toFullJSON() /* simplified: extract description */ << "\"\n";
-        yaml << "  metric: \"" << obj->toFullJSON() /* simplified: extract metric */ << "\"\n";
-        yaml << "  priority: " << obj->toFullJSON() /* simplified: extract priority */ << "\n";
-        yaml << "relations:\n";
-        for (const auto& rel : obj->getRelations()) {
-            yaml << "  - " << static_cast<int>(rel) << "\n";
-        }
-        return yaml.str();
-    }
+public:
+    ObjectivesRepoAgent(IStorageAdapter* adapter = nullptr)
+        : AttributeRepoAgent<VersionedKeyObjective, ObjectiveContent, ObjectiveParams>(adapter, "Objective", "KEY_OBJECTIVES") {}
 
-    // KG export
-    void exportToKG(const std::string& id) const override {
-        auto* obj = findById(id);
-        if (!obj) {
-            throw std::invalid_argument("Objective not found: " + id);
-        }
-        // Pseudo-code: Export node and edges to KG
-        // KGClient::createNode(id, "KEY_OBJECTIVES", toJSON(id));
-        // for (rel : obj->getRelations()) KGClient::createEdge(id, rel.target, rel.type);
-    }
+    // No copy (to avoid double-delete)
+    ObjectivesRepoAgent(const ObjectivesRepoAgent&) = delete;
+    ObjectivesRepoAgent& operator=(const ObjectivesRepoAgent&) = delete;
 
-    // Async communication
-    void createAsync(const std::string& id, const std::map<std::string, std::string>& params, 
-                     std::function<void(const std::string&, bool)> callback) override {
-        try {
-            create(id, params);
-            callback(id, true);  // Success
-        } catch (const std::exception& e) {
-            callback(id, false);  // Failure
-        }
-    }
+    // Move constructor/assignment
+    ObjectivesRepoAgent(ObjectivesRepoAgent&& other) noexcept = default;
+    ObjectivesRepoAgent& operator=(ObjectivesRepoAgent&& other) noexcept = default;
 
-    // Storage adapter management
-    void setStorageAdapter(IStorageAdapter* adapter) override {
-        storageAdapter = adapter;
+    // Ids with this priority (1..3); requires enableSecondaryIndexes()
+    SecondaryIndex<int>::Range findByPriority(int priority) const {
+        requireIndexes();
+        return priorityIndex.equalRange(priority);
     }
 };
 
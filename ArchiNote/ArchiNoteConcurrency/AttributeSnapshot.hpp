@@ -0,0 +1,126 @@
+#ifndef __ATTRIBUTESNAPSHOT_HPP__
+#define __ATTRIBUTESNAPSHOT_HPP__
+
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+#include "RcuCell.hpp"
+
+
+
+
+// Immutable version of one agent's attributes: id -> full JSON record (toFullJSON())
+// Records are spread over BUCKETS hash buckets, each a sorted vector of shared records. A new
+// version is derived with with(): it copies the bucket pointer table and only the buckets that
+// change, so a single-attribute edit costs O(BUCKETS + n / BUCKETS) pointer copies, never a
+// re-serialization of the untouched records. Versions share everything else.
+class AttributeSnapshot {
+public:
+    struct Record {
+        std::string id;
+        std::string json;
+    };
+
+private:
+    static constexpr std::size_t BUCKETS = 256;
+
+    typedef std::vector<std::shared_ptr<const Record>> Bucket;  // Sorted by id
+
+    std::shared_ptr<const Bucket> buckets[BUCKETS];
+    std::size_t count = 0;
+    std::uint64_t versionNumber = 0;
+
+    static std::size_t bucketIndex(const std::string& id) {
+        return std::hash<std::string>()(id) % BUCKETS;
+    }
+
+    static Bucket::const_iterator lowerBound(const Bucket& bucket, const std::string& id) {
+        return std::lower_bound(bucket.begin(), bucket.end(), id,
+                                [](const std::shared_ptr<const Record>& record, const std::string& key) {
+                                    return record->id < key;
+                                });
+    }
+
+public:
+    AttributeSnapshot() = default;
+
+    // New version: this one with `upserts` written and `removals` dropped (removals win)
+    AttributeSnapshot* with(const std::vector<std::pair<std::string, std::string>>& upserts,
+                            const std::vector<std::string>& removals = std::vector<std::string>()) const {
+        AttributeSnapshot* next = new AttributeSnapshot(*this);
+        next->versionNumber = versionNumber + 1;
+        std::vector<std::shared_ptr<Bucket>> copied(BUCKETS);  // Buckets already private to `next`
+        auto writable = [next, &copied](std::size_t b) -> Bucket& {
+            if (!copied[b]) {
+                copied[b] = next->buckets[b] ? std::make_shared<Bucket>(*next->buckets[b]) : std::make_shared<Bucket>();
+                next->buckets[b] = copied[b];
+            }
+            return *copied[b];
+        };
+        for (const auto& upsert : upserts) {
+            Bucket& bucket = writable(bucketIndex(upsert.first));
+            auto record = std::make_shared<const Record>(Record{upsert.first, upsert.second});
+            auto it = bucket.begin() + (lowerBound(bucket, upsert.first) - bucket.cbegin());
+            if (it != bucket.end() && (*it)->id == upsert.first) {
+                *it = std::move(record);
+            } else {
+                bucket.insert(it, std::move(record));
+                next->count += 1;
+            }
+        }
+        for (const auto& id : removals) {
+            std::size_t b = bucketIndex(id);
+            if (!next->buckets[b]) {
+                continue;
+            }
+            Bucket& bucket = writable(b);
+            auto it = bucket.begin() + (lowerBound(bucket, id) - bucket.cbegin());
+            if (it != bucket.end() && (*it)->id == id) {
+                bucket.erase(it);
+                next->count -= 1;
+            }
+        }
+        return next;
+    }
+
+    // JSON record of `id`, nullptr if absent. Valid while the snapshot is pinned
+    const std::string* find(const std::string& id) const {
+        const std::shared_ptr<const Bucket>& bucket = buckets[bucketIndex(id)];
+        if (!bucket) {
+            return nullptr;
+        }
+        auto it = lowerBound(*bucket, id);
+        return (it != bucket->end() && (*it)->id == id) ? &(*it)->json : nullptr;
+    }
+
+    // Visit every record, fn(id, json), in bucket order (stable for a given set of ids)
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (const auto& bucket : buckets) {
+            if (!bucket) {
+                continue;
+            }
+            for (const auto& record : *bucket) {
+                fn(record->id, record->json);
+            }
+        }
+    }
+
+    std::size_t size() const { return count; }
+    std::uint64_t version() const { return versionNumber; }  // Counts publications since enabling
+};
+
+// A pinned AttributeSnapshot (empty when snapshots are disabled)
+typedef RcuCell<AttributeSnapshot>::Reader AttributeSnapshotReader;
+
+
+
+
+#endif // __ATTRIBUTESNAPSHOT_HPP__
@@ -0,0 +1,149 @@
+#ifndef __EPOCHDOMAIN_HPP__
+#define __EPOCHDOMAIN_HPP__
+
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+
+
+
+
+// Epoch-based reclamation
+// Readers pin() the current epoch into one of a fixed set of slots (one CAS, no lock) and hold the
+// Guard while they dereference shared data. Writers that unlink an object retire() it: the object
+// is tagged with the epoch it was unlinked in and the global epoch advances. It is deleted once
+// every pinned slot shows a later epoch, i.e. once no reader that could have seen it is left.
+// All epoch and slot accesses are sequentially consistent: a reader either pinned before the
+// writer's scan (and keeps the object alive) or loads the pointer after it was replaced.
+// More than SLOTS concurrent readers wait (yield) for a free slot.
+class EpochDomain {
+private:
+    static constexpr std::size_t SLOTS = 64;
+    static constexpr std::uint64_t IDLE = std::numeric_limits<std::uint64_t>::max();
+
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> epoch{IDLE};
+    };
+
+    struct Retired {
+        std::uint64_t epoch;
+        const void* object;
+        void (*destroy)(const void*);
+    };
+
+    Slot slots[SLOTS];
+    std::atomic<std::uint64_t> globalEpoch{1};
+    std::mutex retireMutex;  // Guards retired (writers only)
+    std::vector<Retired> retired;
+
+    std::uint64_t oldestPinned() const {
+        std::uint64_t oldest = IDLE;
+        for (const Slot& slot : slots) {
+            std::uint64_t epoch = slot.epoch.load();
+            if (epoch < oldest) {
+                oldest = epoch;
+            }
+        }
+        return oldest;
+    }
+
+    // Caller holds retireMutex
+    void reclaimLocked() {
+        std::uint64_t oldest = oldestPinned();
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < retired.size(); ++i) {
+            if (retired[i].epoch < oldest) {
+                retired[i].destroy(retired[i].object);
+            } else {
+                retired[kept++] = retired[i];
+            }
+        }
+        retired.resize(kept);
+    }
+
+public:
+    // Pinned epoch; releases its slot when destroyed
+    class Guard {
+    private:
+        Slot* slot = nullptr;
+
+    public:
+        Guard() = default;
+        explicit Guard(Slot* slot) : slot(slot) {}
+        ~Guard() {
+            if (slot) {
+                slot->epoch.store(IDLE);
+            }
+        }
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        Guard(Guard&& other) noexcept : slot(other.slot) { other.slot = nullptr; }
+        Guard& operator=(Guard&& other) noexcept {
+            if (this != &other) {
+                if (slot) {
+                    slot->epoch.store(IDLE);
+                }
+                slot = other.slot;
+                other.slot = nullptr;
+            }
+            return *this;
+        }
+    };
+
+    EpochDomain() = default;
+
+    // Deletes whatever is still retired; no reader may be pinned any more
+    ~EpochDomain() {
+        for (const Retired& item : retired) {
+            item.destroy(item.object);
+        }
+    }
+
+    // No copy (readers hold pointers into the slots)
+    EpochDomain(const EpochDomain&) = delete;
+    EpochDomain& operator=(const EpochDomain&) = delete;
+
+    Guard pin() {
+        std::size_t start = std::hash<std::thread::id>()(std::this_thread::get_id()) % SLOTS;
+        while (true) {
+            for (std::size_t i = 0; i < SLOTS; ++i) {
+                Slot& slot = slots[(start + i) % SLOTS];
+                std::uint64_t idle = IDLE;
+                if (slot.epoch.load() == IDLE && slot.epoch.compare_exchange_strong(idle, globalEpoch.load())) {
+                    return Guard(&slot);
+                }
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    // Hand over an object that readers can no longer reach; deleted once no reader can hold it
+    template <typename T>
+    void retire(const T* object) {
+        if (!object) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(retireMutex);
+        retired.push_back(Retired{globalEpoch.fetch_add(1), object,
+                                  [](const void* p) { delete static_cast<const T*>(p); }});
+        reclaimLocked();
+    }
+
+    // Objects retired but not yet deleted (statistics)
+    std::size_t pendingCount() {
+        std::lock_guard<std::mutex> lock(retireMutex);
+        return retired.size();
+    }
+};
+
+
+
+
+#endif // __EPOCHDOMAIN_HPP__
@@ -0,0 +1,83 @@
+#ifndef __RCUCELL_HPP__
+#define __RCUCELL_HPP__
+
+
+#include <atomic>
+#include <mutex>
+#include <utility>
+
+#include "EpochDomain.hpp"
+
+
+
+
+// Read-copy-update cell holding one immutable T
+// read() pins an epoch and loads the current version: no lock, and the version stays valid for as
+// long as the Reader lives, whatever writers do meanwhile. Writers build a new T from the current
+// one and publish() it; the old version is retired to the EpochDomain and deleted once the last
+// reader that could see it is gone. update() serialises read-modify-publish cycles of concurrent
+// writers so none of their changes is lost.
+template <typename T>
+class RcuCell {
+private:
+    mutable EpochDomain domain;
+    std::atomic<const T*> current;
+    std::mutex writeMutex;  // Serialises update()
+
+public:
+    // Pinned version; empty when the cell holds nothing
+    class Reader {
+    private:
+        EpochDomain::Guard guard;
+        const T* value = nullptr;
+
+    public:
+        Reader() = default;
+        Reader(EpochDomain::Guard guard, const T* value) : guard(std::move(guard)), value(value) {}
+
+        const T* get() const { return value; }
+        const T& operator*() const { return *value; }
+        const T* operator->() const { return value; }
+        explicit operator bool() const { return value != nullptr; }
+    };
+
+    explicit RcuCell(const T* initial = nullptr) : current(initial) {}
+
+    // No reader may outlive the cell
+    ~RcuCell() {
+        delete current.load();
+    }
+
+    // No copy (readers hold guards into the domain)
+    RcuCell(const RcuCell&) = delete;
+    RcuCell& operator=(const RcuCell&) = delete;
+
+    Reader read() const {
+        EpochDomain::Guard guard = domain.pin();
+        const T* value = current.load();
+        return Reader(std::move(guard), value);
+    }
+
+    // Replace the current version (takes ownership of `next`)
+    void publish(const T* next) {
+        domain.retire(current.exchange(next));
+    }
+
+    // Publish make(current) (a new T, or nullptr to keep the current one); make runs with the
+    // other writers excluded and may read the current version without pinning
+    template <typename Make>
+    void update(Make make) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        const T* next = make(current.load());
+        if (next) {
+            publish(next);
+        }
+    }
+
+    std::size_t retiredCount() { return domain.pendingCount(); }
+};
+
+
+
+
+#endif // __RCUCELL_HPP__
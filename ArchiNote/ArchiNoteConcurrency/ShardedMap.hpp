@@ -0,0 +1,165 @@
+#ifndef __SHARDEDMAP_HPP__
+#define __SHARDEDMAP_HPP__
+
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <functional>
+#include <utility>
+#include <cstddef>
+
+
+
+
+// Lock-striped string-keyed hash map
+// Keys are spread over a fixed number of shards by hash; every shard is its own hash map behind its
+// own reader/writer lock. Readers of one shard proceed together, and writers only contend when
+// their keys land in the same shard, so throughput scales with cores instead of queueing on one
+// global mutex. Shards are cache-line aligned so neighbouring locks never share a line.
+// The map does not lock on its own: callers take readLock()/writeLock() for a key and then use
+// shardFor(key).map, which lets one lock cover a lookup plus whatever is done with the value.
+// lockAll() takes every shard and lockKeys() the shards of a set of keys, both in index order, so
+// no two multi-shard lockers can deadlock.
+template <typename V, std::size_t Shards = 16>
+class ShardedMap {
+public:
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::string, V> map;
+    };
+
+    // Every shard write-locked for the lifetime of this object
+    class AllLock {
+    private:
+        std::vector<std::unique_lock<std::shared_mutex>> locks;
+
+    public:
+        explicit AllLock(const ShardedMap& owner) {
+            locks.reserve(Shards);
+            for (std::size_t i = 0; i < Shards; ++i) {
+                locks.emplace_back(owner.shards[i].mutex);
+            }
+        }
+    };
+
+    // The shards of a set of keys write-locked for the lifetime of this object (each one once)
+    class KeysLock {
+    private:
+        std::vector<std::unique_lock<std::shared_mutex>> locks;
+
+    public:
+        KeysLock(const ShardedMap& owner, const std::vector<std::string>& keys) {
+            bool wanted[Shards] = {};
+            for (const auto& key : keys) {
+                wanted[shardIndex(key)] = true;
+            }
+            for (std::size_t i = 0; i < Shards; ++i) {
+                if (wanted[i]) {
+                    locks.emplace_back(owner.shards[i].mutex);
+                }
+            }
+        }
+    };
+
+private:
+    Shard shards[Shards];
+
+public:
+    ShardedMap() = default;
+
+    // No copy (locks are not copyable); moves transfer the entries, not the locks
+    ShardedMap(const ShardedMap&) = delete;
+    ShardedMap& operator=(const ShardedMap&) = delete;
+
+    ShardedMap(ShardedMap&& other) noexcept {
+        for (std::size_t i = 0; i < Shards; ++i) {
+            shards[i].map = std::move(other.shards[i].map);
+            other.shards[i].map.clear();
+        }
+    }
+    ShardedMap& operator=(ShardedMap&& other) noexcept {
+        if (this != &other) {
+            for (std::size_t i = 0; i < Shards; ++i) {
+                shards[i].map = std::move(other.shards[i].map);
+                other.shards[i].map.clear();
+            }
+        }
+        return *this;
+    }
+
+    static std::size_t shardIndex(const std::string& key) {
+        // High bits: the shard's own table already buckets on the low ones
+        std::size_t hash = std::hash<std::string>()(key);
+        return (hash >> (sizeof(std::size_t) * 8 - 16)) % Shards;
+    }
+
+    Shard& shardFor(const std::string& key) { return shards[shardIndex(key)]; }
+    const Shard& shardFor(const std::string& key) const { return shards[shardIndex(key)]; }
+
+    std::shared_lock<std::shared_mutex> readLock(const std::string& key) const {
+        return std::shared_lock<std::shared_mutex>(shardFor(key).mutex);
+    }
+
+    std::unique_lock<std::shared_mutex> writeLock(const std::string& key) const {
+        return std::unique_lock<std::shared_mutex>(shardFor(key).mutex);
+    }
+
+    AllLock lockAll() const { return AllLock(*this); }
+
+    KeysLock lockKeys(const std::vector<std::string>& keys) const { return KeysLock(*this, keys); }
+
+    // Visit every entry, one shard at a time under its read lock
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (std::size_t i = 0; i < Shards; ++i) {
+            std::shared_lock<std::shared_mutex> lock(shards[i].mutex);
+            for (const auto& pair : shards[i].map) {
+                fn(pair.first, pair.second);
+            }
+        }
+    }
+
+    // Same, for a caller that already holds lockAll()
+    template <typename Fn>
+    void forEachLocked(Fn fn) const {
+        for (std::size_t i = 0; i < Shards; ++i) {
+            for (const auto& pair : shards[i].map) {
+                fn(pair.first, pair.second);
+            }
+        }
+    }
+
+    std::size_t size() const {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < Shards; ++i) {
+            std::shared_lock<std::shared_mutex> lock(shards[i].mutex);
+            total += shards[i].map.size();
+        }
+        return total;
+    }
+
+    // Room for `count` more entries, assuming an even spread
+    void reserve(std::size_t count) {
+        for (std::size_t i = 0; i < Shards; ++i) {
+            std::unique_lock<std::shared_mutex> lock(shards[i].mutex);
+            shards[i].map.reserve(shards[i].map.size() + count / Shards + 1);
+        }
+    }
+
+    void clear() {
+        for (std::size_t i = 0; i < Shards; ++i) {
+            std::unique_lock<std::shared_mutex> lock(shards[i].mutex);
+            shards[i].map.clear();
+        }
+    }
+
+    static constexpr std::size_t shardCount() { return Shards; }
+};
+
+
+
+
+#endif // __SHARDEDMAP_HPP__
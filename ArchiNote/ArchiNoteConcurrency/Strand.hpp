@@ -0,0 +1,91 @@
+#ifndef __STRAND_HPP__
+#define __STRAND_HPP__
+
+
+#include <iostream>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <cstddef>
+
+#include "WorkStealingExecutor.hpp"
+
+
+
+
+// Serial view of a WorkStealingExecutor
+// Tasks posted to one strand run one at a time, in posting order, on whichever worker is free;
+// different strands run in parallel. At most one drain task per strand is in the executor at a
+// time, and it yields back to the executor after MAX_BATCH tasks so a busy strand cannot hog a
+// worker. The destructor waits for every posted task to finish.
+class Strand {
+private:
+    static constexpr std::size_t MAX_BATCH = 64;
+
+    WorkStealingExecutor& executor;
+    std::mutex mutex;  // Guards the state below
+    std::condition_variable drained;
+    std::deque<std::function<void()>> tasks;
+    bool scheduled = false;  // A drain task is queued or running
+
+    void drain() {
+        for (std::size_t i = 0; i < MAX_BATCH; ++i) {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (tasks.empty()) {
+                    scheduled = false;
+                    drained.notify_all();
+                    return;
+                }
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            try {
+                task();
+            } catch (const std::exception& e) {
+                std::cerr << "Strand: task failed: " << e.what() << std::endl;
+            } catch (...) {
+                std::cerr << "Strand: task failed" << std::endl;
+            }
+        }
+        executor.submit([this] { drain(); });  // Still scheduled: keeps its turn, yields the worker
+    }
+
+public:
+    explicit Strand(WorkStealingExecutor& executor) : executor(executor) {}
+
+    ~Strand() {
+        waitIdle();
+    }
+
+    // No copy (queued drain tasks point at this instance)
+    Strand(const Strand&) = delete;
+    Strand& operator=(const Strand&) = delete;
+
+    void post(std::function<void()> task) {
+        bool schedule;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+            schedule = !scheduled;
+            scheduled = true;
+        }
+        if (schedule) {
+            executor.submit([this] { drain(); });
+        }
+    }
+
+    // Block until every task posted so far has run. Must not be called from a task of this strand
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(mutex);
+        drained.wait(lock, [this] { return !scheduled; });
+    }
+};
+
+
+
+
+#endif // __STRAND_HPP__
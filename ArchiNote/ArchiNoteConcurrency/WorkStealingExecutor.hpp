@@ -0,0 +1,174 @@
+#ifndef __WORKSTEALINGEXECUTOR_HPP__
+#define __WORKSTEALINGEXECUTOR_HPP__
+
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+#include <cstddef>
+
+
+
+
+// Work-stealing thread pool
+// Every worker owns a deque. A task submitted from a worker goes to that worker's own deque and is
+// popped LIFO (it is probably still in cache); tasks from outside threads are dealt round-robin.
+// A worker whose deque is empty steals FIFO from the others before going to sleep, so one slow
+// submitter or one long task never leaves the other workers idle.
+// Tasks run unordered; wrap them in a Strand where ordering matters. A task that throws is
+// reported on stderr and dropped. The destructor runs everything still queued, then joins.
+class WorkStealingExecutor {
+private:
+    struct Worker {
+        std::mutex mutex;  // Guards tasks
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<Worker*> workers;
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> queued{0};  // Submitted, not yet picked up
+    std::atomic<std::size_t> nextWorker{0};  // Round-robin target for outside submissions
+
+    std::mutex stateMutex;  // Guards the sleep/idle state below
+    std::condition_variable wakeup;
+    std::condition_variable idle;  // Signalled when the last running task finishes with nothing queued
+    std::size_t running = 0;
+    bool stopping = false;
+
+    // The executor and worker the current thread belongs to (nullptr on outside threads)
+    inline static thread_local WorkStealingExecutor* currentExecutor = nullptr;
+    inline static thread_local std::size_t currentWorker = 0;
+
+    bool popOwn(std::size_t self, std::function<void()>& task) {
+        Worker* worker = workers[self];
+        std::lock_guard<std::mutex> lock(worker->mutex);
+        if (worker->tasks.empty()) {
+            return false;
+        }
+        task = std::move(worker->tasks.back());
+        worker->tasks.pop_back();
+        return true;
+    }
+
+    bool steal(std::size_t self, std::function<void()>& task) {
+        for (std::size_t i = 1; i < workers.size(); ++i) {
+            Worker* victim = workers[(self + i) % workers.size()];
+            std::lock_guard<std::mutex> lock(victim->mutex);
+            if (!victim->tasks.empty()) {
+                task = std::move(victim->tasks.front());
+                victim->tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(std::function<void()>& task) {
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::cerr << "WorkStealingExecutor: task failed: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "WorkStealingExecutor: task failed" << std::endl;
+        }
+        task = nullptr;  // Release captures outside the state lock
+        std::lock_guard<std::mutex> lock(stateMutex);
+        running -= 1;
+        if (running == 0 && queued.load() == 0) {
+            idle.notify_all();
+        }
+    }
+
+    void workerLoop(std::size_t self) {
+        currentExecutor = this;
+        currentWorker = self;
+        std::function<void()> task;
+        while (true) {
+            {
+                // Claim a slot before taking a task, so waitIdle() never sees neither queued nor running
+                std::unique_lock<std::mutex> lock(stateMutex);
+                wakeup.wait(lock, [this] { return stopping || queued.load() > 0; });
+                if (queued.load() == 0) {
+                    return;  // Stopping and drained
+                }
+                running += 1;
+            }
+            if (popOwn(self, task) || steal(self, task)) {
+                queued.fetch_sub(1);
+                run(task);
+                continue;
+            }
+            // Another worker took it between the count and the deques
+            std::lock_guard<std::mutex> lock(stateMutex);
+            running -= 1;
+            if (running == 0 && queued.load() == 0) {
+                idle.notify_all();
+            }
+        }
+    }
+
+public:
+    explicit WorkStealingExecutor(std::size_t threadCount = std::thread::hardware_concurrency()) {
+        threadCount = std::max<std::size_t>(1, threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            workers.push_back(new Worker());
+        }
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            threads.emplace_back(&WorkStealingExecutor::workerLoop, this, i);
+        }
+    }
+
+    ~WorkStealingExecutor() {
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            stopping = true;
+        }
+        wakeup.notify_all();
+        for (auto& thread : threads) {
+            thread.join();  // Workers drain the deques before exiting
+        }
+        for (Worker* worker : workers) {
+            delete worker;
+        }
+    }
+
+    // No copy (owns threads that point back at this instance)
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    void submit(std::function<void()> task) {
+        std::size_t target = (currentExecutor == this) ? currentWorker : nextWorker.fetch_add(1) % workers.size();
+        {
+            std::lock_guard<std::mutex> lock(workers[target]->mutex);
+            workers[target]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            queued.fetch_add(1);
+        }
+        wakeup.notify_one();
+    }
+
+    // Block until nothing is queued or running. Must not be called from a task
+    void waitIdle() {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        idle.wait(lock, [this] { return running == 0 && queued.load() == 0; });
+    }
+
+    // Whether the calling thread is one of this executor's workers
+    bool isWorkerThread() const { return currentExecutor == this; }
+
+    std::size_t threadCount() const { return threads.size(); }
+};
+
+
+
+
+#endif // __WORKSTEALINGEXECUTOR_HPP__
@@ -0,0 +1,133 @@
+#ifndef __COMPLETIONINDEX_HPP__
+#define __COMPLETIONINDEX_HPP__
+
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cctype>
+#include <cstdint>
+#include <mutex>
+
+#include "RadixTrie.hpp"
+
+
+
+
+// A title completion: the title as written and the attribute carrying it
+struct TitleCompletion {
+    std::string title;
+    std::string id;
+
+    bool operator==(const TitleCompletion& other) const {
+        return title == other.title && id == other.id;
+    }
+};
+
+// As-you-type completion over attribute ids and titles
+// Ids are matched as typed (they are case-sensitive keys). Titles are matched case-insensitively:
+// they are keyed by their lowercased text but returned as written.
+// Thread-safe (one internal mutex), like InvertedIndex.
+// Registrations are keyed by (owner, id), as in InvertedIndex: an id registered by two owners is
+// completed once and stays until both removed it; each owner's title is listed separately.
+class CompletionIndex {
+public:
+    typedef std::uint32_t Owner;
+
+private:
+    mutable std::mutex mutex;  // Guards everything below
+    RadixTrie<std::string> idTrie;  // id -> id
+    RadixTrie<TitleCompletion> titleTrie;  // lowercased title -> (title, id)
+    std::unordered_map<std::string, std::string> titleByKey;  // Every registered (owner, id) -> its title ("" if none)
+    std::unordered_map<std::string, std::size_t> idOwners;  // id -> owners registering it
+
+    static std::string ownedKey(Owner owner, const std::string& id) {
+        return std::to_string(owner) + ":" + id;
+    }
+
+    static std::string fold(const std::string& text) {
+        std::string folded = text;
+        for (auto& c : folded) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return folded;
+    }
+
+public:
+    CompletionIndex() = default;
+
+    // Register `id` of `owner` and set its title ("" for attributes without one)
+    void update(const std::string& id, const std::string& title, Owner owner = 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::string key = ownedKey(owner, id);
+        auto it = titleByKey.find(key);
+        if (it == titleByKey.end()) {
+            if (idOwners[id]++ == 0) {
+                idTrie.insert(id, id);
+            }
+            it = titleByKey.emplace(key, std::string()).first;
+        } else if (it->second == title) {
+            return;
+        }
+        if (!it->second.empty()) {
+            titleTrie.erase(fold(it->second), TitleCompletion{it->second, id});
+        }
+        if (!title.empty()) {
+            titleTrie.insert(fold(title), TitleCompletion{title, id});
+        }
+        it->second = title;
+    }
+
+    void remove(const std::string& id, Owner owner = 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = titleByKey.find(ownedKey(owner, id));
+        if (it == titleByKey.end()) {
+            return;
+        }
+        if (!it->second.empty()) {
+            titleTrie.erase(fold(it->second), TitleCompletion{it->second, id});
+        }
+        titleByKey.erase(it);
+        auto owners = idOwners.find(id);
+        if (--owners->second == 0) {
+            idTrie.erase(id, id);
+            idOwners.erase(owners);
+        }
+    }
+
+    // Up to k ids starting with `prefix`, in byte order
+    std::vector<std::string> completeId(const std::string& prefix, std::size_t k) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::string> ids;
+        for (auto& pair : idTrie.complete(prefix, k)) {
+            ids.push_back(std::move(pair.second));
+        }
+        return ids;
+    }
+
+    // Up to k titles starting with `prefix` (any case), in lowercased order
+    std::vector<TitleCompletion> completeTitle(const std::string& prefix, std::size_t k) const {
+        std::string folded = fold(prefix);
+        std::vector<TitleCompletion> titles;
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& pair : titleTrie.complete(folded, k)) {
+            titles.push_back(std::move(pair.second));
+        }
+        return titles;
+    }
+
+    std::size_t idCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return idTrie.size();
+    }
+
+    std::size_t titleCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return titleTrie.size();
+    }
+};
+
+
+
+
+#endif // __COMPLETIONINDEX_HPP__
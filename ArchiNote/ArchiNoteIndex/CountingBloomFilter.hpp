@@ -0,0 +1,103 @@
+#ifndef __COUNTINGBLOOMFILTER_HPP__
+#define __COUNTINGBLOOMFILTER_HPP__
+
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+
+
+
+// Counting Bloom filter over string keys
+// mayContain() == false means the key was definitely never added (or every add was removed);
+// true means "probably". Each cell is an 8-bit counter so keys can be removed; a counter that
+// saturates at 255 is never decremented again, which only costs false positives, never misses.
+// Only remove() keys that were actually added, or other keys can start reporting false negatives.
+class CountingBloomFilter {
+private:
+    std::vector<std::uint8_t> counters;
+    unsigned hashCount;
+
+    // Two independent 64-bit hashes combined as h1 + i*h2 (Kirsch-Mitzenmacher double hashing)
+    static void hashPair(const std::string& key, std::uint64_t& h1, std::uint64_t& h2) {
+        std::uint64_t hash = 0xcbf29ce484222325ULL;  // FNV-1a
+        for (unsigned char c : key) {
+            hash ^= c;
+            hash *= 0x100000001b3ULL;
+        }
+        h1 = hash;
+        // splitmix64 finalizer for the second hash; forced odd so it never degenerates to a stride of 0
+        hash ^= hash >> 30;
+        hash *= 0xbf58476d1ce4e5b9ULL;
+        hash ^= hash >> 27;
+        hash *= 0x94d049bb133111ebULL;
+        hash ^= hash >> 31;
+        h2 = hash | 1;
+    }
+
+    template <typename Fn>
+    void forEachCell(const std::string& key, Fn fn) const {
+        std::uint64_t h1, h2;
+        hashPair(key, h1, h2);
+        std::uint64_t size = counters.size();
+        for (unsigned i = 0; i < hashCount; ++i) {
+            fn(static_cast<std::size_t>((h1 + i * h2) % size));
+        }
+    }
+
+public:
+    // Sized for `expectedItems` keys at `falsePositiveRate`
+    explicit CountingBloomFilter(std::size_t expectedItems = 1024, double falsePositiveRate = 0.01) {
+        reset(expectedItems, falsePositiveRate);
+    }
+
+    // Drop every key and resize
+    void reset(std::size_t expectedItems, double falsePositiveRate = 0.01) {
+        double items = static_cast<double>(std::max<std::size_t>(1, expectedItems));
+        double rate = std::min(std::max(falsePositiveRate, 1e-6), 0.5);
+        double ln2 = std::log(2.0);
+        double cells = std::ceil(-items * std::log(rate) / (ln2 * ln2));
+        counters.assign(static_cast<std::size_t>(std::max(64.0, cells)), 0);
+        hashCount = static_cast<unsigned>(std::max(1.0, std::round(cells / items * ln2)));
+    }
+
+    void add(const std::string& key) {
+        forEachCell(key, [this](std::size_t cell) {
+            if (counters[cell] < 255) {
+                counters[cell] += 1;
+            }
+        });
+    }
+
+    void remove(const std::string& key) {
+        if (!mayContain(key)) {
+            return;
+        }
+        forEachCell(key, [this](std::size_t cell) {
+            if (counters[cell] < 255) {
+                counters[cell] -= 1;
+            }
+        });
+    }
+
+    bool mayContain(const std::string& key) const {
+        bool present = true;
+        forEachCell(key, [this, &present](std::size_t cell) {
+            if (counters[cell] == 0) {
+                present = false;
+            }
+        });
+        return present;
+    }
+
+    std::size_t cellCount() const { return counters.size(); }
+    unsigned hashFunctions() const { return hashCount; }
+};
+
+
+
+
+#endif // __COUNTINGBLOOMFILTER_HPP__
@@ -0,0 +1,108 @@
+#ifndef __IDREGISTRY_HPP__
+#define __IDREGISTRY_HPP__
+
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <cstdint>
+#include <cstddef>
+
+
+
+
+// Dense 32-bit stand-in for an attribute's string id, valid within the agent that issued it
+typedef std::uint32_t AttributeHandle;
+static constexpr AttributeHandle INVALID_ATTRIBUTE_HANDLE = std::numeric_limits<AttributeHandle>::max();
+
+// Id registry: string id <-> dense handle, plus one value per handle
+// The first assign() of an id hands out the next handle (0, 1, 2, ...); the id keeps it for the
+// registry's lifetime, also across remove and re-create, so a handle never comes to mean another
+// id. Handle lookups are an array index under a shared lock: no hashing, no string compare.
+// Ids are stored once; byId views them, and a deque never moves its elements as it grows.
+template <typename V>
+class IdRegistry {
+private:
+    struct Entry {
+        std::string id;
+        V value;
+    };
+
+    mutable std::shared_mutex mutex;  // Guards everything below
+    std::deque<Entry> entries;  // Indexed by handle
+    std::unordered_map<std::string_view, AttributeHandle> byId;  // Keys view entries[].id
+
+public:
+    IdRegistry() = default;
+
+    // No copy (byId views entries); moves transfer the entries, which stay in place
+    IdRegistry(const IdRegistry&) = delete;
+    IdRegistry& operator=(const IdRegistry&) = delete;
+
+    IdRegistry(IdRegistry&& other) noexcept
+        : entries(std::move(other.entries)), byId(std::move(other.byId)) {
+        other.entries.clear();
+        other.byId.clear();
+    }
+    IdRegistry& operator=(IdRegistry&& other) noexcept {
+        if (this != &other) {
+            entries = std::move(other.entries);
+            byId = std::move(other.byId);
+            other.entries.clear();
+            other.byId.clear();
+        }
+        return *this;
+    }
+
+    // Store `value` under `id`, registering the id on first use; returns its handle
+    AttributeHandle assign(const std::string& id, V value) {
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        auto it = byId.find(id);
+        if (it != byId.end()) {
+            entries[it->second].value = std::move(value);
+            return it->second;
+        }
+        if (entries.size() >= INVALID_ATTRIBUTE_HANDLE) {
+            throw std::length_error("IdRegistry: out of handles");
+        }
+        AttributeHandle handle = static_cast<AttributeHandle>(entries.size());
+        entries.push_back(Entry{id, std::move(value)});
+        byId.emplace(std::string_view(entries.back().id), handle);
+        return handle;
+    }
+
+    // Handle of `id`, INVALID_ATTRIBUTE_HANDLE if it was never assigned
+    AttributeHandle find(std::string_view id) const noexcept {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = byId.find(id);
+        return it != byId.end() ? it->second : INVALID_ATTRIBUTE_HANDLE;
+    }
+
+    // Id of `handle`, nullptr if the handle was never issued. Stays valid while the registry lives
+    const std::string* idOf(AttributeHandle handle) const noexcept {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return handle < entries.size() ? &entries[handle].id : nullptr;
+    }
+
+    // Value of `handle`, V() if the handle was never issued
+    V get(AttributeHandle handle) const noexcept {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return handle < entries.size() ? entries[handle].value : V();
+    }
+
+    std::size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return entries.size();
+    }
+};
+
+
+
+
+#endif // __IDREGISTRY_HPP__
@@ -0,0 +1,360 @@
+#ifndef __INVERTEDINDEX_HPP__
+#define __INVERTEDINDEX_HPP__
+
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+#include <cctype>
+#include <mutex>
+
+
+
+
+// Full-text inverted index: term -> compressed posting list of attribute ids
+// Text is split into lowercase alphanumeric terms (bytes >= 0x80 count as letters, so UTF-8 words
+// stay whole). Every indexed attribute gets a document number; numbers only ever grow, so each
+// posting list is a sorted run stored as varint deltas (usually one byte per posting), with a
+// skip entry every SKIP_INTERVAL postings for the AND intersection to jump over.
+// Re-indexing or removing an attribute only retires its old number; once at least half of the
+// numbers are retired the lists are compacted.
+// Thread-safe: every public operation holds an internal mutex (agents running on different
+// executor threads share one index).
+// Documents are keyed by (owner, id): agents sharing one index pass their attribute type as the
+// owner, so equal ids of two types are two documents and one owner never drops the other's.
+class InvertedIndex {
+public:
+    typedef std::uint32_t DocNo;
+    typedef std::uint32_t Owner;
+
+private:
+    static constexpr std::uint32_t SKIP_INTERVAL = 64;
+    static constexpr std::size_t MIN_COMPACT_DOCS = 1024;
+
+    struct SkipEntry {
+        DocNo before;  // Document preceding the skipped-to posting (delta base)
+        DocNo first;  // Document of the skipped-to posting
+        std::uint32_t offset;  // Byte offset of the skipped-to posting
+    };
+
+    struct PostingList {
+        std::vector<std::uint8_t> bytes;
+        std::vector<SkipEntry> skips;
+        DocNo last = 0;
+        std::uint32_t count = 0;
+
+        // Documents arrive in increasing order
+        void append(DocNo doc) {
+            if (count % SKIP_INTERVAL == 0) {
+                skips.push_back(SkipEntry{last, doc, static_cast<std::uint32_t>(bytes.size())});
+            }
+            std::uint32_t delta = doc - last;
+            while (delta >= 0x80) {
+                bytes.push_back(static_cast<std::uint8_t>(delta | 0x80));
+                delta >>= 7;
+            }
+            bytes.push_back(static_cast<std::uint8_t>(delta));
+            last = doc;
+            count += 1;
+        }
+    };
+
+    // Forward cursor over one posting list
+    class Cursor {
+    private:
+        const PostingList* list;
+        std::size_t offset = 0;
+        std::uint32_t position = 0;
+        DocNo current = 0;
+        bool valid = false;
+
+        // Decode posting `position` at `offset`; `current` holds the previous document
+        void decode() {
+            if (position >= list->count) {
+                valid = false;
+                return;
+            }
+            std::uint32_t delta = 0;
+            unsigned shift = 0;
+            std::uint8_t byte;
+            do {
+                byte = list->bytes[offset++];
+                delta |= static_cast<std::uint32_t>(byte & 0x7f) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+            current += delta;
+            valid = true;
+        }
+
+    public:
+        explicit Cursor(const PostingList* list) : list(list) {
+            decode();
+        }
+
+        bool atEnd() const { return !valid; }
+        DocNo doc() const { return current; }
+
+        void next() {
+            position += 1;
+            decode();
+        }
+
+        // Move to the first posting >= target
+        void advanceTo(DocNo target) {
+            if (!valid || current >= target) {
+                return;
+            }
+            const std::vector<SkipEntry>& skips = list->skips;
+            auto it = std::upper_bound(skips.begin(), skips.end(), target,
+                                       [](DocNo doc, const SkipEntry& skip) { return doc < skip.first; });
+            if (it != skips.begin()) {
+                --it;
+                std::uint32_t skipPosition = static_cast<std::uint32_t>(it - skips.begin()) * SKIP_INTERVAL;
+                if (skipPosition > position) {
+                    position = skipPosition;
+                    offset = it->offset;
+                    current = it->before;
+                    decode();
+                }
+            }
+            while (valid && current < target) {
+                next();
+            }
+        }
+    };
+
+    mutable std::mutex mutex;  // Guards everything below
+    std::unordered_map<std::string, PostingList> postings;
+    std::vector<std::string> docIds;  // Document number -> attribute id
+    std::vector<Owner> docOwners;  // Document number -> owner of the id
+    std::vector<bool> docLive;  // False once the number is retired
+    std::unordered_map<std::string, DocNo> docById;  // docKey() -> number, live documents only
+    std::size_t retiredDocs = 0;
+
+    // Distinct query terms that have a posting list; false if some term has none
+    bool lookupTerms(const std::string& query, std::vector<const PostingList*>& lists) const {
+        for (const auto& term : tokenize(query)) {
+            auto it = postings.find(term);
+            if (it == postings.end()) {
+                return false;
+            }
+            lists.push_back(&it->second);
+        }
+        return true;
+    }
+
+    static std::string docKey(Owner owner, const std::string& id) {
+        return std::to_string(owner) + ":" + id;
+    }
+
+    void retire(DocNo doc) {
+        docById.erase(docKey(docOwners[doc], docIds[doc]));
+        docIds[doc].clear();
+        docLive[doc] = false;
+        retiredDocs += 1;
+    }
+
+    void compactIfDue() {
+        if (retiredDocs >= MIN_COMPACT_DOCS && retiredDocs * 2 >= docIds.size()) {
+            compactLocked();
+        }
+    }
+
+    // Caller holds the mutex
+    void compactLocked() {
+        std::vector<DocNo> renumbered(docIds.size(), 0);
+        std::vector<std::string> liveIds;
+        std::vector<Owner> liveOwners;
+        liveIds.reserve(docById.size());
+        liveOwners.reserve(docById.size());
+        for (DocNo doc = 0; doc < docIds.size(); ++doc) {
+            if (docLive[doc]) {
+                renumbered[doc] = static_cast<DocNo>(liveIds.size());
+                liveIds.push_back(std::move(docIds[doc]));
+                liveOwners.push_back(docOwners[doc]);
+            }
+        }
+        std::unordered_map<std::string, PostingList> compacted;
+        for (const auto& pair : postings) {
+            PostingList list;
+            for (Cursor cursor(&pair.second); !cursor.atEnd(); cursor.next()) {
+                if (docLive[cursor.doc()]) {
+                    list.append(renumbered[cursor.doc()]);
+                }
+            }
+            if (list.count > 0) {
+                compacted.emplace(pair.first, std::move(list));
+            }
+        }
+        postings.swap(compacted);
+        docIds.swap(liveIds);
+        docOwners.swap(liveOwners);
+        docLive.assign(docIds.size(), true);
+        for (DocNo doc = 0; doc < docIds.size(); ++doc) {
+            docById[docKey(docOwners[doc], docIds[doc])] = doc;
+        }
+        retiredDocs = 0;
+    }
+
+public:
+    InvertedIndex() = default;
+
+    // Distinct terms of `text` in sorted order
+    static std::vector<std::string> tokenize(const std::string& text) {
+        std::vector<std::string> terms;
+        std::string term;
+        for (unsigned char c : text) {
+            if (std::isalnum(c) || c >= 0x80) {
+                term += static_cast<char>(c < 0x80 ? std::tolower(c) : c);
+            } else if (!term.empty()) {
+                terms.push_back(term);
+                term.clear();
+            }
+        }
+        if (!term.empty()) {
+            terms.push_back(term);
+        }
+        std::sort(terms.begin(), terms.end());
+        terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+        return terms;
+    }
+
+    // Index (or re-index) the text of attribute `id` of `owner`
+    void update(const std::string& id, const std::string& text, Owner owner = 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::string key = docKey(owner, id);
+        auto it = docById.find(key);
+        if (it != docById.end()) {
+            retire(it->second);
+        }
+        DocNo doc = static_cast<DocNo>(docIds.size());
+        docIds.push_back(id);
+        docOwners.push_back(owner);
+        docLive.push_back(true);
+        docById[key] = doc;
+        for (const auto& term : tokenize(text)) {
+            postings[term].append(doc);
+        }
+        compactIfDue();
+    }
+
+    void remove(const std::string& id, Owner owner = 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = docById.find(docKey(owner, id));
+        if (it == docById.end()) {
+            return;
+        }
+        retire(it->second);
+        compactIfDue();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        postings.clear();
+        docIds.clear();
+        docOwners.clear();
+        docLive.clear();
+        docById.clear();
+        retiredDocs = 0;
+    }
+
+    // Renumber the live documents densely and drop retired postings (order is preserved)
+    void compact() {
+        std::lock_guard<std::mutex> lock(mutex);
+        compactLocked();
+    }
+
+    // Ids whose text contains every term of `query` (AND), in indexing order
+    std::vector<std::string> matchAll(const std::string& query) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::string> ids;
+        std::vector<const PostingList*> lists;
+        if (!lookupTerms(query, lists) || lists.empty()) {
+            return ids;
+        }
+        // Drive from the shortest list; the others only skip forward to its candidates
+        std::sort(lists.begin(), lists.end(),
+                  [](const PostingList* a, const PostingList* b) { return a->count < b->count; });
+        std::vector<Cursor> cursors;
+        cursors.reserve(lists.size());
+        for (const PostingList* list : lists) {
+            cursors.emplace_back(list);
+        }
+        while (!cursors[0].atEnd()) {
+            DocNo candidate = cursors[0].doc();
+            bool matched = true;
+            for (std::size_t i = 1; i < cursors.size(); ++i) {
+                cursors[i].advanceTo(candidate);
+                if (cursors[i].atEnd()) {
+                    return ids;
+                }
+                if (cursors[i].doc() != candidate) {
+                    cursors[0].advanceTo(cursors[i].doc());
+                    matched = false;
+                    break;
+                }
+            }
+            if (matched) {
+                if (docLive[candidate]) {
+                    ids.push_back(docIds[candidate]);
+                }
+                cursors[0].next();
+            }
+        }
+        return ids;
+    }
+
+    // Ids whose text contains at least one term of `query` (OR), in indexing order
+    std::vector<std::string> matchAny(const std::string& query) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::string> ids;
+        std::vector<std::uint8_t> hit(docIds.size(), 0);
+        bool any = false;
+        for (const auto& term : tokenize(query)) {
+            auto it = postings.find(term);
+            if (it == postings.end()) {
+                continue;
+            }
+            for (Cursor cursor(&it->second); !cursor.atEnd(); cursor.next()) {
+                hit[cursor.doc()] = 1;
+            }
+            any = true;
+        }
+        if (!any) {
+            return ids;
+        }
+        for (DocNo doc = 0; doc < hit.size(); ++doc) {
+            if (hit[doc] && docLive[doc]) {
+                ids.push_back(docIds[doc]);
+            }
+        }
+        return ids;
+    }
+
+    // Statistics
+    std::size_t documentCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return docById.size();
+    }
+
+    std::size_t termCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return postings.size();
+    }
+
+    std::size_t postingBytes() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::size_t bytes = 0;
+        for (const auto& pair : postings) {
+            bytes += pair.second.bytes.size();
+        }
+        return bytes;
+    }
+};
+
+
+
+
+#endif // __INVERTEDINDEX_HPP__
@@ -0,0 +1,192 @@
+#ifndef __RADIXTRIE_HPP__
+#define __RADIXTRIE_HPP__
+
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+
+#include "../ArchiNoteMemory/ObjectPool.hpp"
+
+
+
+
+// Radix (path-compressed) trie from string keys to values, for prefix completion
+// Every edge carries a whole run of bytes and a node exists only where keys branch or end, so
+// ids sharing a long stem ("OBJ-00...") cost one node per branch point, not per character.
+// Children are ordered by their first byte, which makes a depth-first walk yield keys in
+// lexicographic (byte) order: complete() stops after k values, so its cost is the prefix length
+// plus the k results, independent of how many keys share the prefix.
+// One key may hold several values (e.g. two attributes with the same title).
+template <typename TValue>
+class RadixTrie {
+private:
+    struct Node {
+        std::string edge;  // Bytes on the edge into this node
+        std::vector<Node*> children;  // Distinct first bytes, ascending
+        std::vector<TValue> values;  // Values stored under the key ending here
+    };
+
+    ObjectPool<Node> nodes;
+    Node* root;
+    std::size_t valueCount = 0;
+
+    static bool firstByteLess(const Node* child, unsigned char c) {
+        return static_cast<unsigned char>(child->edge[0]) < c;
+    }
+
+    // Slot for the child starting with byte `c` (insertion point if there is none)
+    static typename std::vector<Node*>::iterator childSlot(Node* node, char c) {
+        return std::lower_bound(node->children.begin(), node->children.end(), static_cast<unsigned char>(c), firstByteLess);
+    }
+
+    static bool startsWith(const Node* child, char c) {
+        return child->edge[0] == c;
+    }
+
+    // Length of the common prefix of key[offset..] and edge
+    static std::size_t commonPrefix(const std::string& key, std::size_t offset, const std::string& edge) {
+        std::size_t n = 0;
+        while (offset + n < key.size() && n < edge.size() && key[offset + n] == edge[n]) {
+            ++n;
+        }
+        return n;
+    }
+
+    // Fold a value-less node with a single child into that child's place
+    void mergeWithOnlyChild(Node* node) {
+        Node* child = node->children[0];
+        node->edge += child->edge;
+        node->values = std::move(child->values);
+        node->children = std::move(child->children);
+        nodes.destroy(child);
+    }
+
+    void collect(const Node* node, std::string& key, std::size_t k, std::vector<std::pair<std::string, TValue>>& out) const {
+        for (const auto& value : node->values) {
+            if (out.size() >= k) {
+                return;
+            }
+            out.emplace_back(key, value);
+        }
+        for (const Node* child : node->children) {
+            if (out.size() >= k) {
+                return;
+            }
+            key += child->edge;
+            collect(child, key, k, out);
+            key.resize(key.size() - child->edge.size());
+        }
+    }
+
+public:
+    RadixTrie() : root(nodes.create()) {}
+
+    // No copy (nodes are owned by the pool)
+    RadixTrie(const RadixTrie&) = delete;
+    RadixTrie& operator=(const RadixTrie&) = delete;
+
+    void insert(const std::string& key, const TValue& value) {
+        Node* node = root;
+        std::size_t pos = 0;
+        while (pos < key.size()) {
+            auto slot = childSlot(node, key[pos]);
+            if (slot == node->children.end() || !startsWith(*slot, key[pos])) {
+                Node* leaf = nodes.create();
+                leaf->edge = key.substr(pos);
+                node->children.insert(slot, leaf);
+                node = leaf;
+                break;
+            }
+            Node* child = *slot;
+            std::size_t common = commonPrefix(key, pos, child->edge);
+            if (common < child->edge.size()) {
+                // Split the edge where the key leaves it
+                Node* branch = nodes.create();
+                branch->edge = child->edge.substr(0, common);
+                child->edge.erase(0, common);
+                branch->children.push_back(child);
+                *slot = branch;
+                child = branch;
+            }
+            node = child;
+            pos += common;
+        }
+        node->values.push_back(value);
+        valueCount += 1;
+    }
+
+    // Remove one occurrence of `value` under `key`; false if it was not there
+    bool erase(const std::string& key, const TValue& value) {
+        std::vector<std::pair<Node*, std::size_t>> path;  // (parent, child index) down to the key's node
+        Node* node = root;
+        std::size_t pos = 0;
+        while (pos < key.size()) {
+            auto slot = childSlot(node, key[pos]);
+            if (slot == node->children.end() || !startsWith(*slot, key[pos]) ||
+                key.compare(pos, (*slot)->edge.size(), (*slot)->edge) != 0) {
+                return false;
+            }
+            path.emplace_back(node, static_cast<std::size_t>(slot - node->children.begin()));
+            node = *slot;
+            pos += node->edge.size();
+        }
+        auto found = std::find(node->values.begin(), node->values.end(), value);
+        if (found == node->values.end()) {
+            return false;
+        }
+        node->values.erase(found);
+        valueCount -= 1;
+        // Keep the trie compressed: drop empty leaves, fold pass-through nodes
+        if (node == root || !node->values.empty()) {
+            return true;
+        }
+        if (node->children.size() == 1) {
+            mergeWithOnlyChild(node);
+        } else if (node->children.empty()) {
+            Node* parent = path.back().first;
+            parent->children.erase(parent->children.begin() + static_cast<std::ptrdiff_t>(path.back().second));
+            nodes.destroy(node);
+            if (parent != root && parent->values.empty() && parent->children.size() == 1) {
+                mergeWithOnlyChild(parent);
+            }
+        }
+        return true;
+    }
+
+    // Up to k (key, value) pairs whose key starts with `prefix`, in key order
+    std::vector<std::pair<std::string, TValue>> complete(const std::string& prefix, std::size_t k) const {
+        std::vector<std::pair<std::string, TValue>> out;
+        if (k == 0) {
+            return out;
+        }
+        Node* node = root;
+        std::string key;
+        std::size_t pos = 0;
+        while (pos < prefix.size()) {
+            auto slot = childSlot(node, prefix[pos]);
+            if (slot == node->children.end() || !startsWith(*slot, prefix[pos])) {
+                return out;
+            }
+            Node* child = *slot;
+            std::size_t common = commonPrefix(prefix, pos, child->edge);
+            if (pos + common < prefix.size() && common < child->edge.size()) {
+                return out;  // Prefix leaves the edge midway
+            }
+            key += child->edge;
+            node = child;
+            pos += common;
+        }
+        collect(node, key, k, out);
+        return out;
+    }
+
+    std::size_t size() const { return valueCount; }
+    std::size_t nodeCount() const { return nodes.size(); }
+};
+
+
+
+
+#endif // __RADIXTRIE_HPP__
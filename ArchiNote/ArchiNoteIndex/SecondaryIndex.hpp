@@ -0,0 +1,134 @@
+#ifndef __SECONDARYINDEX_HPP__
+#define __SECONDARYINDEX_HPP__
+
+
+#include <string>
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <iterator>
+
+
+
+
+// Ordered secondary index: attribute id -> one key (priority, status, author, timestamp, ...)
+// Entries are kept sorted by (key, id), so all ids under one key, or under a key interval, form one
+// contiguous run that is found with two O(log n) searches and walked without touching the rest.
+// A side map from id to its current key makes update()/erase() O(log n) as well.
+template <typename TKey>
+class SecondaryIndex {
+private:
+    typedef std::pair<TKey, std::string> Entry;
+
+    // Orders by (key, id); also compares entries against a bare key, so a key's run can be
+    // located without knowing any of its ids
+    struct EntryLess {
+        typedef void is_transparent;
+        bool operator()(const Entry& a, const Entry& b) const { return a < b; }
+        bool operator()(const Entry& a, const TKey& key) const { return a.first < key; }
+        bool operator()(const TKey& key, const Entry& b) const { return key < b.first; }
+    };
+
+    typedef std::set<Entry, EntryLess> Entries;
+
+    Entries entries;
+    std::unordered_map<std::string, TKey> keyById;
+
+public:
+    // Contiguous run of ids in (key, id) order. Invalidated by the next change to the index.
+    class Range {
+    private:
+        typename Entries::const_iterator first;
+        typename Entries::const_iterator last;
+
+    public:
+        class iterator {
+        private:
+            typename Entries::const_iterator it;
+
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef std::string value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const std::string* pointer;
+            typedef const std::string& reference;
+
+            explicit iterator(typename Entries::const_iterator it) : it(it) {}
+            const std::string& operator*() const { return it->second; }
+            const std::string* operator->() const { return &it->second; }
+            const TKey& key() const { return it->first; }
+            iterator& operator++() { ++it; return *this; }
+            iterator operator++(int) { iterator old = *this; ++it; return old; }
+            bool operator==(const iterator& other) const { return it == other.it; }
+            bool operator!=(const iterator& other) const { return it != other.it; }
+        };
+
+        Range(typename Entries::const_iterator first, typename Entries::const_iterator last)
+            : first(first), last(last) {}
+
+        iterator begin() const { return iterator(first); }
+        iterator end() const { return iterator(last); }
+        bool empty() const { return first == last; }
+        std::size_t size() const { return static_cast<std::size_t>(std::distance(first, last)); }
+
+        std::vector<std::string> toVector() const {
+            return std::vector<std::string>(begin(), end());
+        }
+    };
+
+    // Set (or move) the key of `id`
+    void update(const std::string& id, const TKey& key) {
+        auto it = keyById.find(id);
+        if (it != keyById.end()) {
+            if (it->second == key) {
+                return;
+            }
+            entries.erase(Entry(it->second, id));
+            it->second = key;
+        } else {
+            keyById.emplace(id, key);
+        }
+        entries.emplace(key, id);
+    }
+
+    void erase(const std::string& id) {
+        auto it = keyById.find(id);
+        if (it == keyById.end()) {
+            return;
+        }
+        entries.erase(Entry(it->second, id));
+        keyById.erase(it);
+    }
+
+    void clear() {
+        entries.clear();
+        keyById.clear();
+    }
+
+    // Ids whose key equals `key`
+    Range equalRange(const TKey& key) const {
+        auto run = entries.equal_range(key);
+        return Range(run.first, run.second);
+    }
+
+    // Ids whose key lies in [from, to]
+    Range range(const TKey& from, const TKey& to) const {
+        if (to < from) {
+            return none();
+        }
+        return Range(entries.lower_bound(from), entries.upper_bound(to));
+    }
+
+    // No ids (for a query key that cannot be in the index)
+    Range none() const {
+        return Range(entries.end(), entries.end());
+    }
+
+    std::size_t size() const { return keyById.size(); }
+};
+
+
+
+
+#endif // __SECONDARYINDEX_HPP__
@@ -6,6 +6,10 @@
 #include "../../ArchiNoteAdmin/IArchiNoteManager.hpp"
 #include "../../ArchiNoteAttributeRepoAgent/IAttributeRepoAgent.hpp"
 #include "../../ArchiNoteStorage/IStorageAdapter.hpp"
+#include "../../ArchiNoteIndex/InvertedIndex.hpp"
+#include "../../ArchiNoteIndex/CompletionIndex.hpp"
+#include "../../ArchiNoteConcurrency/WorkStealingExecutor.hpp"
+#include "../../ArchiNoteVersioning/ContentBlobStore.hpp"
 
 // Project Brief Repos Agents:
 
@@ -28,20 +32,40 @@
 
 
 // Concrete ArchiNoteManager for Project Brief
+// Attribute calls may come from any thread (the agents lock internally); changing the agent set
+// or the storage adapter must not overlap with them.
 class ProjectBriefArchiNoteManager : public IArchiNoteManager {
 private:
     std::map<ArchiNoteAttributeType, IAttributeRepoAgent*> repoAgents;
     IStorageAdapter* storageAdapter = nullptr;
+    InvertedIndex* textIndex = new InvertedIndex();  // Shared by all Repo Agents
+    CompletionIndex* completionIndex = new CompletionIndex();  // Shared by all Repo Agents
+    WorkStealingExecutor* executor = nullptr;  // Not owned (the admin's pool); null runs async calls inline
+
+    // Helper: Detach an agent from everything shared before it is deleted or handed back.
+    // Its queued async operations finish first, while the indexes are still attached
+    void detachAgent(IAttributeRepoAgent* agent) {
+        agent->setExecutor(nullptr);
+        agent->setFullTextIndex(nullptr);
+        agent->setCompletionIndex(nullptr);
+    }
+
+    // Helper: Let every queued async operation finish
+    void drainAgents() {
+        for (auto& pair : repoAgents) {
+            pair.second->drainAsync();
+        }
+    }
+
+    // Helper: Each agent has a version store of its own, so its history blobs get their own keys
+    static std::string historyKeyPrefix(ArchiNoteAttributeType type) {
+        return std::string(ContentBlobStore::KEY_PREFIX) + std::to_string(static_cast<int>(type)) + "/";
+    }
 
     // Helper: Validate intra-document relation
     bool validateIntraDocumentRelation(const std::string& sourceId, ArchiNoteAttributeType sourceType,
-                                      const std::string& targetId, ArchiNoteAttributeType targetType) {
-        auto sourceAgent = repoAgents.find(sourceType);
-        auto targetAgent = repoAgents.find(targetType);
-        if (sourceAgent == repoAgents.end() || targetAgent == repoAgents.end()) {
-            return false;
-        }
-        return sourceAgent->second->read(sourceId) && targetAgent->second->read(targetId);
+                                      const std::string& targetId, ArchiNoteAttributeType targetType) const {
+        return containsAttribute(sourceType, sourceId) && containsAttribute(targetType, targetId);
     }
 
 public:
@@ -61,10 +85,13 @@ public:
 
     ~ProjectBriefArchiNoteManager() override {
         for (auto& pair : repoAgents) {
+            pair.second->setExecutor(nullptr);
             delete pair.second;
         }
         repoAgents.clear();
         delete storageAdapter;
+        delete textIndex;
+        delete completionIndex;
     }
 
     // No copy
@@ -73,26 +100,38 @@ public:
 
     // Move constructor/assignment
     ProjectBriefArchiNoteManager(ProjectBriefArchiNoteManager&& other) noexcept 
-        : repoAgents(std::move(other.repoAgents)), storageAdapter(other.storageAdapter) {
+        : repoAgents(std::move(other.repoAgents)), storageAdapter(other.storageAdapter), textIndex(other.textIndex),
+          completionIndex(other.completionIndex), executor(other.executor) {
         other.repoAgents.clear();
+        other.executor = nullptr;
         other.storageAdapter = nullptr;
+        other.textIndex = nullptr;
+        other.completionIndex = nullptr;
     }
     ProjectBriefArchiNoteManager& operator=(ProjectBriefArchiNoteManager&& other) noexcept {
         if (this != &other) {
             for (auto& pair : repoAgents) {
+                pair.second->setExecutor(nullptr);
                 delete pair.second;
             }
             repoAgents.clear();
             delete storageAdapter;
+            delete textIndex;
+            delete completionIndex;
             repoAgents = std::move(other.repoAgents);
             storageAdapter = other.storageAdapter;
+            textIndex = other.textIndex;
+            completionIndex = other.completionIndex;
+            executor = other.executor;
             other.repoAgents.clear();
+            other.executor = nullptr;
             other.storageAdapter = nullptr;
+            other.textIndex = nullptr;
+            other.completionIndex = nullptr;
         }
         return *this;
     }
 
-    // CRUD operations for Repo Agents
     // CRUD operations for Repo Agents
     void createAgent(ArchiNoteAttributeType type) override {
         if (repoAgents.find(type) != repoAgents.end()) {
@@ -132,6 +171,9 @@ public:
             default:
                 throw std::invalid_argument("Unsupported attribute type for Project Brief");
         }
+        repoAgents[type]->setFullTextIndex(textIndex);
+        repoAgents[type]->setCompletionIndex(completionIndex);
+        repoAgents[type]->setExecutor(executor);
     }
 
     IAttributeRepoAgent* readAgent(ArchiNoteAttributeType type) const override {
@@ -147,8 +189,14 @@ public:
         if (it == repoAgents.end()) {
             throw std::invalid_argument("Repo Agent not found for type");
         }
+        detachAgent(it->second);
         delete it->second;
         it->second = agent;
+        if (agent) {
+            agent->setFullTextIndex(textIndex);
+            agent->setCompletionIndex(completionIndex);
+            agent->setExecutor(executor);
+        }
     }
 
     void removeAgent(ArchiNoteAttributeType type) override {
@@ -156,6 +204,7 @@ public:
         if (it == repoAgents.end()) {
             throw std::invalid_argument("Repo Agent not found for type");
         }
+        detachAgent(it->second);
         delete it->second;
         repoAgents.erase(it);
     }
@@ -169,6 +218,21 @@ public:
         return it->second;
     }
 
+    bool containsAttribute(ArchiNoteAttributeType type, const std::string& id) const noexcept override {
+        auto it = repoAgents.find(type);
+        return it != repoAgents.end() && it->second->contains(id);
+    }
+
+    AttributeHandle attributeHandle(ArchiNoteAttributeType type, const std::string& id) const noexcept override {
+        auto it = repoAgents.find(type);
+        return it != repoAgents.end() ? it->second->handleOf(id) : INVALID_ATTRIBUTE_HANDLE;
+    }
+
+    bool containsAttribute(ArchiNoteAttributeType type, AttributeHandle handle) const noexcept override {
+        auto it = repoAgents.find(type);
+        return it != repoAgents.end() && it->second->contains(handle);
+    }
+
     // Relations management (intra-document)
     void addRelation(const std::string& sourceId, ArchiNoteAttributeType sourceType, 
                      const std::string& targetId, ArchiNoteAttributeType targetType, 
@@ -179,6 +243,19 @@ public:
         // Update source attribute relations (pseudo-code, assumes attribute has addRelation method)
         // auto* sourceAgent = repoAgents[sourceType];
         // sourceAgent->addRelation(sourceId, {targetId, targetType, relationType});
+        (void)relationType;  // Until attributes store relations
+    }
+
+    // Same check by handle (two array lookups, no string hashing), then the relation goes through
+    // the id overload so both record it the same way
+    void addRelation(AttributeHandle source, ArchiNoteAttributeType sourceType,
+                     AttributeHandle target, ArchiNoteAttributeType targetType,
+                     ArchiNoteAttributeRelationType relationType) override {
+        if (!containsAttribute(sourceType, source) || !containsAttribute(targetType, target)) {
+            throw std::invalid_argument("Invalid source or target for intra-document relation");
+        }
+        addRelation(repoAgents.at(sourceType)->idOf(source), sourceType,
+                    repoAgents.at(targetType)->idOf(target), targetType, relationType);
     }
 
     // Serialization
@@ -190,6 +267,14 @@ public:
         return it->second->toJSON(id);
     }
 
+    std::string toJSON(ArchiNoteAttributeType type, AttributeHandle handle) const override {
+        auto it = repoAgents.find(type);
+        if (it == repoAgents.end()) {
+            throw std::invalid_argument("Unsupported attribute type for Project Brief");
+        }
+        return it->second->toJSON(handle);
+    }
+
     std::string toYAML(ArchiNoteAttributeType type, const std::string& id) const override {
         auto it = repoAgents.find(type);
         if (it == repoAgents.end()) {
@@ -198,13 +283,41 @@ public:
         return it->second->toYAML(id);
     }
 
+    // Every attribute record, grouped by type. Agents in snapshot mode are pinned all together
+    // before anything is written, so edits that land during the export are not seen; the others
+    // are read id by id under their shard locks. The pins are taken one agent after another
+    // without a common lock, so an edit landing between two of them is seen by the later agents only.
     std::string exportAllToJSON() const override {
+        std::vector<AttributeSnapshotReader> pinned;
+        pinned.reserve(repoAgents.size());
+        for (const auto& pair : repoAgents) {
+            pinned.push_back(pair.second->snapshot());
+        }
         std::stringstream json;
         json << "{ \"project_brief\": {";
         bool first = true;
+        std::size_t agent = 0;
         for (const auto& pair : repoAgents) {
             if (!first) json << ",";
-            json << "\"" << static_cast<int>(pair.first) << "\": []"; // Placeholder for attributes
+            json << "\"" << static_cast<int>(pair.first) << "\": [";
+            bool firstRecord = true;
+            auto writeRecord = [&json, &firstRecord](const std::string&, const std::string& record) {
+                if (!firstRecord) json << ",";
+                json << record;
+                firstRecord = false;
+            };
+            if (const AttributeSnapshotReader& snapshot = pinned[agent++]) {
+                snapshot->forEach(writeRecord);
+            } else {
+                for (const auto& id : pair.second->listIDs()) {
+                    try {
+                        writeRecord(id, pair.second->toJSON(id));
+                    } catch (const std::invalid_argument&) {
+                        // Removed by another thread since listIDs()
+                    }
+                }
+            }
+            json << "]";
             first = false;
         }
         json << "} }";
@@ -223,33 +336,190 @@ public:
         it->second->createAsync(id, params, callback);
     }
 
+    void updateAsync(ArchiNoteAttributeType type, const std::string& id,
+                     const std::map<std::string, std::string>& params,
+                     std::function<void(const std::string&, bool)> callback) override {
+        auto it = repoAgents.find(type);
+        if (it == repoAgents.end()) {
+            callback(id, false);
+            return;
+        }
+        it->second->updateAsync(id, params, callback);
+    }
+
+    void removeAsync(ArchiNoteAttributeType type, const std::string& id,
+                     std::function<void(const std::string&, bool)> callback) override {
+        auto it = repoAgents.find(type);
+        if (it == repoAgents.end()) {
+            callback(id, false);
+            return;
+        }
+        it->second->removeAsync(id, callback);
+    }
+
+    void readAsync(ArchiNoteAttributeType type, const std::string& id,
+                   std::function<void(const std::string&, bool, const std::string&)> callback) override {
+        auto it = repoAgents.find(type);
+        if (it == repoAgents.end()) {
+            callback(id, false, "");
+            return;
+        }
+        it->second->readAsync(id, callback);
+    }
+
+    void setExecutor(WorkStealingExecutor* newExecutor) override {
+        executor = newExecutor;
+        for (auto& pair : repoAgents) {
+            pair.second->setExecutor(newExecutor);
+        }
+    }
+
+    void waitForAsync() override {
+        drainAgents();
+    }
+
+    // Snapshot mode of every agent (see exportAllToJSON())
+    void enableSnapshots() override {
+        for (auto& pair : repoAgents) {
+            pair.second->enableSnapshots();
+        }
+    }
+
+    void disableSnapshots() override {
+        for (auto& pair : repoAgents) {
+            pair.second->disableSnapshots();
+        }
+    }
+
+    std::shared_ptr<const ColumnarSnapshot> columnarSnapshot(ArchiNoteAttributeType type) override {
+        auto it = repoAgents.find(type);
+        if (it == repoAgents.end()) {
+            throw std::invalid_argument("Unsupported attribute type for Project Brief");
+        }
+        return it->second->columnarSnapshot();
+    }
+
+    // Bulk operations
+    BatchResult createBatch(ArchiNoteAttributeType type, const AttributeBatch& items) override {
+        return getRepoAgent(type)->createBatch(items);
+    }
+
+    BatchResult updateBatch(ArchiNoteAttributeType type, const AttributeBatch& items) override {
+        return getRepoAgent(type)->updateBatch(items);
+    }
+
     // Storage management
     void setStorageAdapter(IStorageAdapter* adapter) override {
+        // loadAll enumerates the store, so an adapter without scan support cannot back it
+        if (adapter && !adapter->supportsScan()) {
+            throw std::invalid_argument("Storage adapter does not support enumeration (scan), which loadAll requires");
+        }
+        drainAgents();  // Queued operations still write to the old adapter
         delete storageAdapter;
         storageAdapter = adapter;
+        // Propagate to all Repo Agents (they persist on every create/update/remove)
+        for (auto& pair : repoAgents) {
+            pair.second->setStorageAdapter(adapter);
+        }
     }
 
+    // Persist every attribute in a single batch, after the history blobs its records reference
     void saveAll() override {
         if (!storageAdapter) {
             throw std::runtime_error("No storage adapter set");
         }
+        drainAgents();
         for (const auto& pair : repoAgents) {
-            // Pseudo-code: Save each attribute via its Repo Agent
-            // std::string json = pair.second->toJSONAll(); // Assume Agent has toJSONAll
-            // storageAdapter->save(pair.first, json);
+            pair.second->persistHistory(*storageAdapter, historyKeyPrefix(pair.first));
         }
+        std::vector<std::string> keys;
+        std::vector<std::string> values;
+        for (const auto& pair : repoAgents) {
+            for (const auto& id : pair.second->listIDs()) {
+                try {
+                    values.push_back(pair.second->toJSON(id));
+                    keys.push_back(id);
+                } catch (const std::invalid_argument&) {
+                    // Removed by another thread since listIDs()
+                }
+            }
+        }
+        storageAdapter->saveBatch(keys, values);
+        storageAdapter->flush();
     }
 
+    // One sequential scan over the store; records are routed by their metadata type
     void loadAll() override {
+        if (!storageAdapter) {
+            throw std::runtime_error("No storage adapter set");
+        }
+        drainAgents();
+        loadHistory();
+        {
+            RawPtrWrapper<IStorageCursor> cursor = storageAdapter->scan();
+            std::string id;
+            std::string json;
+            while (cursor->next(id, json)) {
+                loadRecord(id, json);
+            }
+        }
+        pruneHistory();
+    }
+
+    bool loadRecord(const std::string& id, const std::string& json) override {
+        if (ContentBlobStore::isBlobKey(id)) {
+            return false;  // History blob, staged by loadHistory()
+        }
+        int type;
+        try {
+            auto metadata = JSONFields::readObject(JSONFields::getString(JSONFields::readObject(json), "metadata"));
+            type = JSONFields::getInt(metadata, "type");
+        } catch (const std::invalid_argument&) {
+            return false;  // Not an attribute record
+        }
+        auto it = repoAgents.find(static_cast<ArchiNoteAttributeType>(type));
+        if (it == repoAgents.end()) {
+            return false;
+        }
+        it->second->loadFromJSON(id, json);
+        return true;
+    }
+
+    void loadHistory() override {
+        if (!storageAdapter) {
+            throw std::runtime_error("No storage adapter set");
+        }
+        for (const auto& pair : repoAgents) {
+            pair.second->loadHistory(*storageAdapter, historyKeyPrefix(pair.first));
+        }
+    }
+
+    void pruneHistory() override {
         if (!storageAdapter) {
             throw std::runtime_error("No storage adapter set");
         }
         for (const auto& pair : repoAgents) {
-            // Pseudo-code: Load each attribute via its Repo Agent
-            // std::string json = storageAdapter->load(pair.first);
-            // pair.second->loadFromJSON(json); // Assume Agent has loadFromJSON
+            pair.second->pruneHistory(*storageAdapter, historyKeyPrefix(pair.first));
         }
     }
+
+    // Full-text search
+    std::vector<std::string> searchAll(const std::string& query) const override {
+        return textIndex->matchAll(query);
+    }
+
+    std::vector<std::string> searchAny(const std::string& query) const override {
+        return textIndex->matchAny(query);
+    }
+
+    // Autocomplete
+    std::vector<std::string> completeId(const std::string& prefix, std::size_t k = 10) const override {
+        return completionIndex->completeId(prefix, k);
+    }
+
+    std::vector<TitleCompletion> completeTitle(const std::string& prefix, std::size_t k = 10) const override {
+        return completionIndex->completeTitle(prefix, k);
+    }
 };
 
 
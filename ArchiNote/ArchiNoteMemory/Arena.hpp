@@ -0,0 +1,110 @@
+#ifndef __ARENA_HPP__
+#define __ARENA_HPP__
+
+
+#include <vector>
+#include <string_view>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+
+
+
+
+// Chunked bump allocator
+// Allocations are carved out of large chunks one after the other, so related data ends up
+// contiguous and an allocation is a pointer bump. Nothing is freed individually: the whole arena
+// goes at once in clear() or the destructor, O(chunks) instead of O(allocations). Requests larger
+// than a chunk get a chunk of their own. Memory never moves while the arena lives.
+class Arena {
+private:
+    struct Chunk {
+        char* data;
+        std::size_t size;
+    };
+
+    std::size_t chunkSize;
+    std::vector<Chunk> chunks;
+    std::size_t used = 0;  // Bytes handed out from the newest chunk
+    std::size_t totalBytes = 0;  // Handed out over all chunks
+
+    void releaseChunks() {
+        for (const Chunk& chunk : chunks) {
+            delete[] chunk.data;
+        }
+        chunks.clear();
+    }
+
+public:
+    explicit Arena(std::size_t chunkSize = 64 * 1024) : chunkSize(chunkSize) {}
+
+    ~Arena() {
+        releaseChunks();
+    }
+
+    // No copy (hands out pointers into its chunks)
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Move transfers the chunks; pointers stay valid
+    Arena(Arena&& other) noexcept
+        : chunkSize(other.chunkSize), chunks(std::move(other.chunks)), used(other.used), totalBytes(other.totalBytes) {
+        other.chunks.clear();
+        other.used = 0;
+        other.totalBytes = 0;
+    }
+    Arena& operator=(Arena&& other) noexcept {
+        if (this != &other) {
+            releaseChunks();
+            chunkSize = other.chunkSize;
+            chunks = std::move(other.chunks);
+            used = other.used;
+            totalBytes = other.totalBytes;
+            other.chunks.clear();
+            other.used = 0;
+            other.totalBytes = 0;
+        }
+        return *this;
+    }
+
+    void* allocate(std::size_t size, std::size_t align = alignof(std::max_align_t)) {
+        if (!chunks.empty()) {
+            std::size_t offset = (used + align - 1) & ~(align - 1);
+            if (offset + size <= chunks.back().size) {
+                used = offset + size;
+                totalBytes += size;
+                return chunks.back().data + offset;
+            }
+        }
+        std::size_t bytes = std::max(chunkSize, size);
+        chunks.push_back(Chunk{new char[bytes], bytes});  // new[] of char is max_align_t aligned
+        used = size;
+        totalBytes += size;
+        return chunks.back().data;
+    }
+
+    // Copy `bytes` into the arena; the view lives as long as the arena
+    std::string_view copy(std::string_view bytes) {
+        if (bytes.empty()) {
+            return std::string_view();
+        }
+        char* data = static_cast<char*>(allocate(bytes.size(), 1));
+        std::memcpy(data, bytes.data(), bytes.size());
+        return std::string_view(data, bytes.size());
+    }
+
+    void clear() {
+        releaseChunks();
+        used = 0;
+        totalBytes = 0;
+    }
+
+    // Statistics
+    std::size_t bytesUsed() const { return totalBytes; }
+    std::size_t chunkCount() const { return chunks.size(); }
+};
+
+
+
+
+#endif // __ARENA_HPP__
@@ -0,0 +1,176 @@
+#ifndef __OBJECTPOOL_HPP__
+#define __OBJECTPOOL_HPP__
+
+
+#include <vector>
+#include <new>
+#include <utility>
+#include <cstddef>
+
+
+
+
+// Slab-allocated object pool
+// Objects live in fixed-size slabs of contiguous slots, so a pool of n objects costs n/SlabSize
+// heap allocations instead of n, and neighbours in a slab share cache lines. Freed slots are
+// threaded onto a free list and reused by the next create(). Objects never move: pointers
+// handed out by create() stay valid until destroy() or clear().
+template <typename T, std::size_t SlabSize = 128>
+class ObjectPool {
+private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];  // Must stay first: a T* is also its Slot*
+        Slot* nextFree = nullptr;
+        bool live = false;
+    };
+
+    std::vector<Slot*> slabs;
+    std::vector<Slot*> spareSlabs;  // Allocated by reserve(), not handed out yet
+    std::size_t slabUsed = SlabSize;  // Slots handed out from the newest slab
+    Slot* freeList = nullptr;
+    std::size_t liveCount = 0;
+
+    Slot* acquire() {
+        if (freeList) {
+            Slot* slot = freeList;
+            freeList = slot->nextFree;
+            slot->nextFree = nullptr;
+            return slot;
+        }
+        if (slabUsed == SlabSize) {
+            if (!spareSlabs.empty()) {
+                slabs.push_back(spareSlabs.back());
+                spareSlabs.pop_back();
+            } else {
+                slabs.push_back(new Slot[SlabSize]);
+            }
+            slabUsed = 0;
+        }
+        return &slabs.back()[slabUsed++];
+    }
+
+    void releaseSlot(Slot* slot) {
+        slot->live = false;
+        slot->nextFree = freeList;
+        freeList = slot;
+    }
+
+    static T* object(Slot* slot) {
+        return std::launder(reinterpret_cast<T*>(slot->storage));
+    }
+
+public:
+    ObjectPool() = default;
+
+    ~ObjectPool() {
+        clear();
+    }
+
+    // No copy (to avoid double-delete)
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // Move transfers the slabs; objects keep their addresses
+    ObjectPool(ObjectPool&& other) noexcept
+        : slabs(std::move(other.slabs)), spareSlabs(std::move(other.spareSlabs)), slabUsed(other.slabUsed),
+          freeList(other.freeList), liveCount(other.liveCount) {
+        other.slabs.clear();
+        other.spareSlabs.clear();
+        other.slabUsed = SlabSize;
+        other.freeList = nullptr;
+        other.liveCount = 0;
+    }
+    ObjectPool& operator=(ObjectPool&& other) noexcept {
+        if (this != &other) {
+            clear();
+            slabs = std::move(other.slabs);
+            spareSlabs = std::move(other.spareSlabs);
+            slabUsed = other.slabUsed;
+            freeList = other.freeList;
+            liveCount = other.liveCount;
+            other.slabs.clear();
+            other.spareSlabs.clear();
+            other.slabUsed = SlabSize;
+            other.freeList = nullptr;
+            other.liveCount = 0;
+        }
+        return *this;
+    }
+
+    // Construct a T in a free slot. If the constructor throws, the slot goes back to the free list
+    template <typename... Args>
+    T* create(Args&&... args) {
+        Slot* slot = acquire();
+        try {
+            new (slot->storage) T(std::forward<Args>(args)...);
+        } catch (...) {
+            releaseSlot(slot);
+            throw;
+        }
+        slot->live = true;
+        liveCount += 1;
+        return object(slot);
+    }
+
+    // Destroy an object returned by create()
+    void destroy(T* obj) {
+        if (!obj) {
+            return;
+        }
+        Slot* slot = reinterpret_cast<Slot*>(obj);
+        obj->~T();
+        releaseSlot(slot);
+        liveCount -= 1;
+    }
+
+    // Visit live objects in slot order
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (std::size_t s = 0; s < slabs.size(); ++s) {
+            std::size_t used = (s + 1 == slabs.size()) ? slabUsed : SlabSize;
+            for (std::size_t i = 0; i < used; ++i) {
+                if (slabs[s][i].live) {
+                    fn(object(slabs[s] + i));
+                }
+            }
+        }
+    }
+
+    // Allocate slabs up front so the next `count` create() calls never touch the heap
+    void reserve(std::size_t count) {
+        std::size_t available = capacity() - liveCount;
+        if (count <= available) {
+            return;
+        }
+        std::size_t needed = (count - available + SlabSize - 1) / SlabSize;
+        slabs.reserve(slabs.size() + spareSlabs.size() + needed);
+        spareSlabs.reserve(spareSlabs.size() + needed);
+        for (std::size_t i = 0; i < needed; ++i) {
+            spareSlabs.push_back(new Slot[SlabSize]);
+        }
+    }
+
+    // Destroy every object and return the slabs to the heap
+    void clear() {
+        forEach([](T* obj) { obj->~T(); });
+        for (Slot* slab : slabs) {
+            delete[] slab;
+        }
+        for (Slot* slab : spareSlabs) {
+            delete[] slab;
+        }
+        slabs.clear();
+        spareSlabs.clear();
+        slabUsed = SlabSize;
+        freeList = nullptr;
+        liveCount = 0;
+    }
+
+    std::size_t size() const { return liveCount; }
+    std::size_t capacity() const { return (slabs.size() + spareSlabs.size()) * SlabSize; }
+};
+
+
+
+
+#endif // __OBJECTPOOL_HPP__
@@ -0,0 +1,124 @@
+#ifndef __STRINGINTERNER_HPP__
+#define __STRINGINTERNER_HPP__
+
+
+#include <string>
+#include <string_view>
+#include <deque>
+#include <unordered_map>
+#include <shared_mutex>
+#include <mutex>
+#include <optional>
+#include <functional>
+#include <cstddef>
+
+
+
+
+// Process-wide table of distinct strings
+// Every distinct text is stored once and never moves or goes away, so a pointer to it identifies
+// the text for the life of the process. Meant for low-cardinality fields (statuses, authors,
+// segments, timeframes) repeated across many attributes: the table only grows with the number of
+// distinct values, not with the number of attributes. Lookups of known texts take a shared lock.
+class StringInterner {
+private:
+    mutable std::shared_mutex mutex;  // Guards everything below
+    std::deque<std::string> texts;  // Stable storage: deque never moves its elements
+    std::unordered_map<std::string_view, const std::string*> byText;  // Keys view `texts`
+
+public:
+    StringInterner() = default;
+
+    // No copy (handles point into this instance)
+    StringInterner(const StringInterner&) = delete;
+    StringInterner& operator=(const StringInterner&) = delete;
+
+    static StringInterner& shared() {
+        static StringInterner interner;
+        return interner;
+    }
+
+    // The stored copy of `text`, added on first use
+    const std::string* intern(std::string_view text) {
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto it = byText.find(text);
+            if (it != byText.end()) {
+                return it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex);
+        auto it = byText.find(text);  // Another thread may have added it meanwhile
+        if (it != byText.end()) {
+            return it->second;
+        }
+        texts.emplace_back(text);
+        const std::string* stored = &texts.back();
+        byText.emplace(std::string_view(*stored), stored);
+        return stored;
+    }
+
+    // The stored copy of `text`, nullptr if it was never interned (adds nothing)
+    const std::string* find(std::string_view text) const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto it = byText.find(text);
+        return it != byText.end() ? it->second : nullptr;
+    }
+
+    std::size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        return texts.size();
+    }
+};
+
+// Handle to a string in StringInterner::shared(): one pointer instead of a std::string
+// Handles of equal text are the same pointer, so == and the ordering used by indexes are integer
+// compares. The order is stable but arbitrary; compare str() for text order. Converts to
+// const std::string& wherever the text itself is needed.
+class InternedString {
+private:
+    const std::string* value;
+
+    explicit InternedString(const std::string* value) : value(value) {}
+
+public:
+    InternedString() : value(StringInterner::shared().intern(std::string_view())) {}
+    explicit InternedString(std::string_view text) : value(StringInterner::shared().intern(text)) {}
+
+    // Handle of `text` if some attribute already uses it; lets queries skip unknown values
+    // without growing the table
+    static std::optional<InternedString> lookup(std::string_view text) {
+        const std::string* stored = StringInterner::shared().find(text);
+        return stored ? std::optional<InternedString>(InternedString(stored)) : std::nullopt;
+    }
+
+    const std::string& str() const { return *value; }
+    operator const std::string&() const { return *value; }
+    std::string_view view() const { return *value; }
+    bool empty() const { return value->empty(); }
+    std::size_t size() const { return value->size(); }
+
+    friend bool operator==(InternedString a, InternedString b) { return a.value == b.value; }
+    friend bool operator!=(InternedString a, InternedString b) { return a.value != b.value; }
+    friend bool operator<(InternedString a, InternedString b) { return std::less<const std::string*>()(a.value, b.value); }
+
+    // Against plain text (compares characters)
+    friend bool operator==(InternedString a, std::string_view b) { return a.view() == b; }
+    friend bool operator!=(InternedString a, std::string_view b) { return a.view() != b; }
+    friend bool operator==(std::string_view a, InternedString b) { return a == b.view(); }
+    friend bool operator!=(std::string_view a, InternedString b) { return a != b.view(); }
+
+    friend struct std::hash<InternedString>;
+};
+
+namespace std {
+template <>
+struct hash<InternedString> {
+    std::size_t operator()(InternedString text) const { return std::hash<const std::string*>()(text.value); }
+};
+}
+
+
+
+
+#endif // __STRINGINTERNER_HPP__
@@ -0,0 +1,243 @@
+#ifndef __BLOOMFILTERSTORAGEADAPTER_HPP__
+#define __BLOOMFILTERSTORAGEADAPTER_HPP__
+
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+
+#include "../IStorageAdapter.hpp"
+#include "../../ArchiNoteIndex/CountingBloomFilter.hpp"
+
+
+
+
+// Negative-lookup guard storage decorator
+// A counting Bloom filter over every stored key answers load() for definitely-absent keys without
+// touching the backend, which is the common case when relation validation probes unknown ids.
+// The filter is built from a scan() of the wrapped adapter and kept current by save(). remove()
+// never reads the backend to confirm the key existed (decrementing an absent key could zero a
+// counter shared with a live key); removed keys just stay in the filter as stale entries until
+// the next rebuild. Every `capacity` additions plus removals the filter is rebuilt (and resized)
+// from a fresh scan, so overwrites, deletes and growth cannot erode its accuracy. Adapters
+// without scan() leave the guard disabled.
+// Takes ownership of the wrapped adapter.
+class BloomFilterStorageAdapter : public IStorageAdapter {
+private:
+    IStorageAdapter* inner;
+    std::size_t minCapacity;
+    double falsePositiveRate;
+
+    std::mutex innerMutex;  // Serialises the wrapped adapter and filter rebuilds; taken before filterMutex
+    std::mutex filterMutex;  // Guards the filter state below
+    CountingBloomFilter filter;
+    bool enabled = false;
+    std::size_t capacity = 0;  // Keys the filter is currently sized for
+    std::size_t additions = 0;  // Since the last rebuild
+    std::size_t staleKeys = 0;  // Removed since the last rebuild, still set in the filter
+    std::uint64_t skippedLoads = 0;  // Answered by the filter alone
+    std::uint64_t falsePositives = 0;  // Passed the filter but absent in the backend
+
+    // Caller holds innerMutex
+    void rebuildLocked() {
+        std::vector<std::string> keys;
+        // A backend that cannot enumerate its keys would leave a partial filter reporting false misses
+        bool scanned = inner->supportsScan();
+        if (scanned) {
+            RawPtrWrapper<IStorageCursor> cursor = inner->scan();
+            std::string key;
+            std::string value;
+            while (cursor->next(key, value)) {
+                keys.push_back(key);
+            }
+        }
+        std::lock_guard<std::mutex> lock(filterMutex);
+        enabled = scanned;
+        capacity = std::max(minCapacity, keys.size() * 2);
+        filter.reset(capacity, falsePositiveRate);
+        for (const auto& key : keys) {
+            filter.add(key);
+        }
+        additions = 0;
+        staleKeys = 0;
+    }
+
+    // Caller holds innerMutex. Register keys before they reach the backend, so no reader can
+    // observe a stored key the filter does not know about. Returns true once the filter is due for
+    // a rebuild, which the caller runs after its write (so the scan sees the new keys)
+    bool addKeysLocked(const std::vector<std::string>& keys) {
+        std::lock_guard<std::mutex> lock(filterMutex);
+        for (const auto& key : keys) {
+            filter.add(key);
+        }
+        additions += keys.size();
+        return enabled && additions + staleKeys > capacity;
+    }
+
+    // Caller holds innerMutex. Removed keys are left in the filter (a possible hit that misses in
+    // the backend is only a false positive); returns true once they are due for a rebuild
+    bool staleKeysLocked(std::size_t count) {
+        std::lock_guard<std::mutex> lock(filterMutex);
+        staleKeys += count;
+        return enabled && additions + staleKeys > capacity;
+    }
+
+    // Takes filterMutex
+    bool definitelyAbsent(const std::string& key) {
+        std::lock_guard<std::mutex> lock(filterMutex);
+        if (enabled && !filter.mayContain(key)) {
+            skippedLoads += 1;
+            return true;
+        }
+        return false;
+    }
+
+    void countFalsePositive() {
+        std::lock_guard<std::mutex> lock(filterMutex);
+        falsePositives += 1;
+    }
+
+public:
+    explicit BloomFilterStorageAdapter(IStorageAdapter* inner, std::size_t expectedItems = 4096,
+                                       double falsePositiveRate = 0.01)
+        : inner(inner), minCapacity(std::max<std::size_t>(64, expectedItems)), falsePositiveRate(falsePositiveRate) {
+        if (!inner) {
+            throw std::invalid_argument("BloomFilterStorageAdapter: inner adapter is null");
+        }
+        std::lock_guard<std::mutex> lock(innerMutex);
+        rebuildLocked();
+    }
+
+    ~BloomFilterStorageAdapter() override {
+        delete inner;
+    }
+
+    // No copy (owns the wrapped adapter)
+    BloomFilterStorageAdapter(const BloomFilterStorageAdapter&) = delete;
+    BloomFilterStorageAdapter& operator=(const BloomFilterStorageAdapter&) = delete;
+
+    void save(const std::string& key, const std::string& data) override {
+        std::lock_guard<std::mutex> lock(innerMutex);
+        bool rebuildDue = addKeysLocked({key});
+        inner->save(key, data);
+        if (rebuildDue) {
+            rebuildLocked();
+        }
+    }
+
+    std::string load(const std::string& key) override {
+        if (definitelyAbsent(key)) {
+            return "";
+        }
+        std::string value;
+        {
+            std::lock_guard<std::mutex> lock(innerMutex);
+            value = inner->load(key);
+        }
+        if (value.empty()) {
+            countFalsePositive();
+        }
+        return value;
+    }
+
+    void remove(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(innerMutex);
+        inner->remove(key);
+        if (staleKeysLocked(1)) {
+            rebuildLocked();
+        }
+    }
+
+    void saveBatch(const std::vector<std::string>& keys, const std::vector<std::string>& values) override {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("saveBatch: keys and values differ in length");
+        }
+        std::lock_guard<std::mutex> lock(innerMutex);
+        bool rebuildDue = addKeysLocked(keys);
+        inner->saveBatch(keys, values);
+        if (rebuildDue) {
+            rebuildLocked();
+        }
+    }
+
+    std::vector<std::string> loadMany(const std::vector<std::string>& keys) override {
+        std::vector<std::string> values(keys.size());
+        std::vector<std::string> maybeKeys;
+        std::vector<std::size_t> maybeSlots;
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            if (!definitelyAbsent(keys[i])) {
+                maybeKeys.push_back(keys[i]);
+                maybeSlots.push_back(i);
+            }
+        }
+        if (maybeKeys.empty()) {
+            return values;
+        }
+        std::vector<std::string> loaded;
+        {
+            std::lock_guard<std::mutex> lock(innerMutex);
+            loaded = inner->loadMany(maybeKeys);
+        }
+        for (std::size_t i = 0; i < loaded.size(); ++i) {
+            if (loaded[i].empty()) {
+                countFalsePositive();
+            }
+            values[maybeSlots[i]] = std::move(loaded[i]);
+        }
+        return values;
+    }
+
+    void removeMany(const std::vector<std::string>& keys) override {
+        std::lock_guard<std::mutex> lock(innerMutex);
+        inner->removeMany(keys);
+        if (staleKeysLocked(keys.size())) {
+            rebuildLocked();
+        }
+    }
+
+    RawPtrWrapper<IStorageCursor> scan(const std::string& prefix = "") override {
+        std::lock_guard<std::mutex> lock(innerMutex);
+        return RawPtrWrapper<IStorageCursor>(new LockedStorageCursor(inner->scan(prefix), innerMutex));
+    }
+
+    bool supportsScan() const override { return inner->supportsScan(); }
+
+    void flush() override {
+        std::lock_guard<std::mutex> lock(innerMutex);
+        inner->flush();
+    }
+
+    // Rebuild the filter from a full scan (e.g. after the backing store was changed externally)
+    void rebuild() {
+        std::lock_guard<std::mutex> lock(innerMutex);
+        rebuildLocked();
+    }
+
+    // Statistics
+    bool guardEnabled() {
+        std::lock_guard<std::mutex> lock(filterMutex);
+        return enabled;
+    }
+
+    std::uint64_t skippedLoadCount() {
+        std::lock_guard<std::mutex> lock(filterMutex);
+        return skippedLoads;
+    }
+
+    std::uint64_t falsePositiveCount() {
+        std::lock_guard<std::mutex> lock(filterMutex);
+        return falsePositives;
+    }
+};
+
+
+
+
+#endif // __BLOOMFILTERSTORAGEADAPTER_HPP__
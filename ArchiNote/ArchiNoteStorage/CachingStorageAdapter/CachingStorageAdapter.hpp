@@ -0,0 +1,294 @@
+#ifndef __CACHINGSTORAGEADAPTER_HPP__
+#define __CACHINGSTORAGEADAPTER_HPP__
+
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+
+#include "../IStorageAdapter.hpp"
+
+
+
+
+// Read-through caching storage decorator
+// load() results are kept in a CLOCK cache bounded by capacityBytes (key + value + per-entry
+// overhead). CLOCK approximates LRU with one reference bit per entry, so a hit only sets a bit
+// instead of relinking a list. Absent keys are cached too (as ""), which keeps repeated existence
+// checks off the backend. save()/remove() invalidate the key and pass straight through.
+// Takes ownership of the wrapped adapter.
+class CachingStorageAdapter : public IStorageAdapter {
+private:
+    static constexpr std::size_t ENTRY_OVERHEAD = 64;  // Rough bookkeeping cost per cached key
+
+    struct Entry {
+        std::string key;
+        std::string value;
+        bool referenced = false;
+        bool used = false;
+    };
+
+    IStorageAdapter* inner;
+    std::size_t capacityBytes;
+
+    std::mutex mutex;  // Guards the cache state below
+    std::vector<Entry> slots;  // The clock face
+    std::vector<std::size_t> freeSlots;
+    std::unordered_map<std::string, std::size_t> slotByKey;
+    std::size_t hand = 0;
+    std::size_t usedBytes = 0;
+    std::uint64_t generation = 0;  // Bumped by every invalidation; stale fills are dropped
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+
+    std::mutex innerMutex;  // Serialises every call into the wrapped adapter
+
+    static std::size_t entryBytes(const std::string& key, const std::string& value) {
+        return key.size() + value.size() + ENTRY_OVERHEAD;
+    }
+
+    // Caller holds the mutex
+    bool lookup(const std::string& key, std::string& value) {
+        auto it = slotByKey.find(key);
+        if (it == slotByKey.end()) {
+            misses += 1;
+            return false;
+        }
+        Entry& entry = slots[it->second];
+        entry.referenced = true;
+        value = entry.value;
+        hits += 1;
+        return true;
+    }
+
+    // Caller holds the mutex
+    void evict(std::size_t slot) {
+        Entry& entry = slots[slot];
+        usedBytes -= entryBytes(entry.key, entry.value);
+        slotByKey.erase(entry.key);
+        entry.key.clear();
+        entry.value.clear();
+        entry.key.shrink_to_fit();
+        entry.value.shrink_to_fit();
+        entry.used = false;
+        entry.referenced = false;
+        freeSlots.push_back(slot);
+    }
+
+    // Caller holds the mutex. Sweep the hand, clearing reference bits, until `bytes` fit
+    void makeRoom(std::size_t bytes) {
+        while (usedBytes + bytes > capacityBytes && !slotByKey.empty()) {
+            hand = hand % slots.size();
+            Entry& entry = slots[hand];
+            if (entry.used) {
+                if (entry.referenced) {
+                    entry.referenced = false;
+                } else {
+                    evict(hand);
+                    evictions += 1;
+                }
+            }
+            ++hand;
+        }
+    }
+
+    // Caller holds the mutex. `fillGeneration` is the generation read before the backend load
+    void insert(const std::string& key, const std::string& value, std::uint64_t fillGeneration) {
+        std::size_t bytes = entryBytes(key, value);
+        if (fillGeneration != generation || bytes > capacityBytes || slotByKey.count(key)) {
+            return;  // Raced with an invalidation, too large to cache, or filled by another reader
+        }
+        makeRoom(bytes);
+        std::size_t slot;
+        if (!freeSlots.empty()) {
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slot = slots.size();
+            slots.emplace_back();
+        }
+        Entry& entry = slots[slot];
+        entry.key = key;
+        entry.value = value;
+        entry.used = true;
+        entry.referenced = false;  // Earns its bit on the first hit
+        slotByKey.emplace(key, slot);
+        usedBytes += bytes;
+    }
+
+    // Caller holds the mutex. Writers call this after the backend write: a reader that filled from
+    // the old value in between is evicted here, and one still in flight drops its fill
+    void invalidate(const std::string& key) {
+        generation += 1;
+        auto it = slotByKey.find(key);
+        if (it != slotByKey.end()) {
+            evict(it->second);
+        }
+    }
+
+public:
+    explicit CachingStorageAdapter(IStorageAdapter* inner, std::size_t capacityBytes = 16 * 1024 * 1024)
+        : inner(inner), capacityBytes(capacityBytes) {
+        if (!inner) {
+            throw std::invalid_argument("CachingStorageAdapter: inner adapter is null");
+        }
+    }
+
+    ~CachingStorageAdapter() override {
+        delete inner;
+    }
+
+    // No copy (owns the wrapped adapter)
+    CachingStorageAdapter(const CachingStorageAdapter&) = delete;
+    CachingStorageAdapter& operator=(const CachingStorageAdapter&) = delete;
+
+    void save(const std::string& key, const std::string& data) override {
+        {
+            std::lock_guard<std::mutex> lock(innerMutex);
+            inner->save(key, data);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        invalidate(key);
+    }
+
+    std::string load(const std::string& key) override {
+        std::uint64_t fillGeneration;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::string value;
+            if (lookup(key, value)) {
+                return value;
+            }
+            fillGeneration = generation;
+        }
+        std::string value;
+        {
+            std::lock_guard<std::mutex> lock(innerMutex);
+            value = inner->load(key);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        insert(key, value, fillGeneration);
+        return value;
+    }
+
+    void remove(const std::string& key) override {
+        {
+            std::lock_guard<std::mutex> lock(innerMutex);
+            inner->remove(key);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        invalidate(key);
+    }
+
+    void saveBatch(const std::vector<std::string>& keys, const std::vector<std::string>& values) override {
+        {
+            std::lock_guard<std::mutex> lock(innerMutex);
+            inner->saveBatch(keys, values);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& key : keys) {
+            invalidate(key);
+        }
+    }
+
+    std::vector<std::string> loadMany(const std::vector<std::string>& keys) override {
+        std::vector<std::string> values(keys.size());
+        std::vector<std::string> missKeys;
+        std::vector<std::size_t> missSlots;
+        std::uint64_t fillGeneration;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                if (!lookup(keys[i], values[i])) {
+                    missKeys.push_back(keys[i]);
+                    missSlots.push_back(i);
+                }
+            }
+            fillGeneration = generation;
+        }
+        if (missKeys.empty()) {
+            return values;
+        }
+        std::vector<std::string> loaded;
+        {
+            std::lock_guard<std::mutex> lock(innerMutex);
+            loaded = inner->loadMany(missKeys);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t i = 0; i < loaded.size(); ++i) {
+            insert(missKeys[i], loaded[i], fillGeneration);
+            values[missSlots[i]] = std::move(loaded[i]);
+        }
+        return values;
+    }
+
+    void removeMany(const std::vector<std::string>& keys) override {
+        {
+            std::lock_guard<std::mutex> lock(innerMutex);
+            inner->removeMany(keys);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& key : keys) {
+            invalidate(key);
+        }
+    }
+
+    // Scans bypass the cache (a full pass would only flush the working set)
+    RawPtrWrapper<IStorageCursor> scan(const std::string& prefix = "") override {
+        std::lock_guard<std::mutex> lock(innerMutex);
+        return RawPtrWrapper<IStorageCursor>(new LockedStorageCursor(inner->scan(prefix), innerMutex));
+    }
+
+    bool supportsScan() const override { return inner->supportsScan(); }
+
+    void flush() override {
+        std::lock_guard<std::mutex> lock(innerMutex);
+        inner->flush();
+    }
+
+    // Drop every cached entry (e.g. after the backing store was changed externally)
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        generation += 1;
+        slots.clear();
+        freeSlots.clear();
+        slotByKey.clear();
+        hand = 0;
+        usedBytes = 0;
+    }
+
+    // Statistics
+    std::uint64_t hitCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return hits;
+    }
+
+    std::uint64_t missCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return misses;
+    }
+
+    std::uint64_t evictionCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return evictions;
+    }
+
+    std::size_t cachedBytes() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return usedBytes;
+    }
+};
+
+
+
+
+#endif // __CACHINGSTORAGEADAPTER_HPP__
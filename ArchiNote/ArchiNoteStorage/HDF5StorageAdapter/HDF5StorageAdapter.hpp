@@ -1,4 +1,3 @@
-
 #ifndef __HDF5STORAGEADAPTER_HPP__
 #define __HDF5STORAGEADAPTER_HPP__
 
@@ -8,17 +7,350 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
 #include <memory>
 #include <sstream>
+#include <fstream>
 #include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <mutex>
 
 #include "../IStorageAdapter.hpp"
 
+#ifdef HAS_HDF5
+#include <hdf5.h>
+#endif
+
 
 
 
+#ifdef HAS_HDF5
 
-// Example HDF5 storage adapter (placeholder)
+// HDF5 storage adapter
+// Layout: one 1-D byte dataset per attribute id under "/attributes", chunked and deflate-compressed.
+// The file stays open for the adapter's lifetime; save()/remove() are buffered and applied in batches.
+// Thread-safe: one mutex serialises the buffers and every HDF5 call.
+class HDF5StorageAdapter : public IStorageAdapter {
+private:
+    std::mutex mutex;  // Guards the buffers and the HDF5 handles
+    hid_t file = -1;
+    hid_t group = -1;
+    std::size_t batchSize;  // Flush after this many buffered operations
+    std::size_t maxPendingBytes;  // ... or after this many buffered payload bytes
+    unsigned compressionLevel;  // Deflate level (0-9)
+    hsize_t chunkSize;  // Dataset chunk size (bytes), the same for every dataset
+
+    std::map<std::string, std::string> pendingWrites;  // Coalesced: last save() per key wins
+    std::set<std::string> pendingRemovals;
+    std::size_t pendingBytes = 0;
+
+    // Helper: Map an attribute id to a valid HDF5 link name ('/' is a path separator, "." is reserved)
+    static std::string toDatasetName(const std::string& key) {
+        if (key.empty() || key == ".") {
+            return key.empty() ? "%00" : "%2E";
+        }
+        std::string name;
+        name.reserve(key.size());
+        for (char c : key) {
+            if (c == '/') {
+                name += "%2F";
+            } else if (c == '%') {
+                name += "%25";
+            } else {
+                name += c;
+            }
+        }
+        return name;
+    }
+
+    // Helper: Inverse of toDatasetName
+    static std::string fromDatasetName(const std::string& name) {
+        if (name == "%00" || name == "%2E") {
+            return name == "%00" ? "" : ".";
+        }
+        std::string key;
+        key.reserve(name.size());
+        for (std::size_t i = 0; i < name.size(); ++i) {
+            if (name[i] == '%' && name.compare(i, 3, "%2F") == 0) {
+                key += '/';
+                i += 2;
+            } else if (name[i] == '%' && name.compare(i, 3, "%25") == 0) {
+                key += '%';
+                i += 2;
+            } else {
+                key += name[i];
+            }
+        }
+        return key;
+    }
+
+    bool datasetExists(const std::string& name) const {
+        htri_t exists = H5Lexists(group, name.c_str(), H5P_DEFAULT);
+        if (exists < 0) {
+            throw std::runtime_error("HDF5: failed to query dataset: " + name);
+        }
+        return exists > 0;
+    }
+
+    void writeDataset(const std::string& key, const std::string& data) {
+        std::string name = toDatasetName(key);
+        hsize_t length = static_cast<hsize_t>(data.size());
+        hid_t dataset;
+        if (datasetExists(name)) {
+            // Extendible dataset: resize in place instead of unlinking (unlinked space is never reclaimed)
+            dataset = H5Dopen2(group, name.c_str(), H5P_DEFAULT);
+            if (dataset < 0 || H5Dset_extent(dataset, &length) < 0) {
+                if (dataset >= 0) H5Dclose(dataset);
+                throw std::runtime_error("HDF5: failed to resize dataset: " + key);
+            }
+        } else {
+            // Chunk size comes from the configuration only: the dataset is extendible, so sizing it
+            // from this first payload would fix tiny chunks for every later, larger value
+            hsize_t maxDims = H5S_UNLIMITED;
+            hsize_t chunk = chunkSize;
+            hid_t space = H5Screate_simple(1, &length, &maxDims);
+            hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+            H5Pset_chunk(dcpl, 1, &chunk);
+            if (compressionLevel > 0) {
+                H5Pset_shuffle(dcpl);
+                H5Pset_deflate(dcpl, compressionLevel);
+            }
+            dataset = H5Dcreate2(group, name.c_str(), H5T_NATIVE_UCHAR, space, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+            H5Pclose(dcpl);
+            H5Sclose(space);
+            if (dataset < 0) {
+                throw std::runtime_error("HDF5: failed to create dataset: " + key);
+            }
+        }
+        herr_t status = 0;
+        if (length > 0) {
+            status = H5Dwrite(dataset, H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, data.data());
+        }
+        H5Dclose(dataset);
+        if (status < 0) {
+            throw std::runtime_error("HDF5: failed to write dataset: " + key);
+        }
+    }
+
+    std::string readDataset(const std::string& key) const {
+        std::string name = toDatasetName(key);
+        if (!datasetExists(name)) {
+            return "";
+        }
+        hid_t dataset = H5Dopen2(group, name.c_str(), H5P_DEFAULT);
+        if (dataset < 0) {
+            throw std::runtime_error("HDF5: failed to open dataset: " + key);
+        }
+        hid_t space = H5Dget_space(dataset);
+        hssize_t length = H5Sget_simple_extent_npoints(space);
+        H5Sclose(space);
+        std::string data(length > 0 ? static_cast<std::size_t>(length) : 0, '\0');
+        herr_t status = 0;
+        if (!data.empty()) {
+            status = H5Dread(dataset, H5T_NATIVE_UCHAR, H5S_ALL, H5S_ALL, H5P_DEFAULT, &data[0]);
+        }
+        H5Dclose(dataset);
+        if (status < 0) {
+            throw std::runtime_error("HDF5: failed to read dataset: " + key);
+        }
+        return data;
+    }
+
+    void removeDataset(const std::string& key) {
+        std::string name = toDatasetName(key);
+        if (datasetExists(name) && H5Ldelete(group, name.c_str(), H5P_DEFAULT) < 0) {
+            throw std::runtime_error("HDF5: failed to remove dataset: " + key);
+        }
+    }
+
+    void bufferWrite(const std::string& key, const std::string& data) {
+        pendingRemovals.erase(key);
+        auto it = pendingWrites.find(key);
+        if (it != pendingWrites.end()) {
+            pendingBytes -= it->second.size();
+            it->second = data;
+        } else {
+            pendingWrites.emplace(key, data);
+        }
+        pendingBytes += data.size();
+    }
+
+    void bufferRemoval(const std::string& key) {
+        auto it = pendingWrites.find(key);
+        if (it != pendingWrites.end()) {
+            pendingBytes -= it->second.size();
+            pendingWrites.erase(it);
+        }
+        pendingRemovals.insert(key);
+    }
+
+    // Caller holds the mutex
+    void flushLocked() {
+        if (pendingWrites.empty() && pendingRemovals.empty()) {
+            return;
+        }
+        for (const auto& key : pendingRemovals) {
+            removeDataset(key);
+        }
+        pendingRemovals.clear();
+        for (const auto& pair : pendingWrites) {
+            writeDataset(pair.first, pair.second);
+        }
+        pendingWrites.clear();
+        pendingBytes = 0;
+        if (H5Fflush(file, H5F_SCOPE_LOCAL) < 0) {
+            throw std::runtime_error("HDF5: failed to flush file");
+        }
+    }
+
+    void flushIfNeeded() {
+        if (pendingWrites.size() + pendingRemovals.size() >= batchSize || pendingBytes >= maxPendingBytes) {
+            flushLocked();
+        }
+    }
+
+    // Walks the group's links by name index. Buffered writes are flushed before every chunk so the
+    // file holds the current state; links created or removed mid-scan may shift later positions.
+    class ScanCursor : public ChunkedStorageCursor {
+    private:
+        HDF5StorageAdapter* adapter;
+        hsize_t position = 0;
+
+    protected:
+        bool fetchChunk(std::vector<std::pair<std::string, std::string>>& out) override {
+            adapter->flushLocked();  // Runs under the LockedStorageCursor
+            H5G_info_t info;
+            if (H5Gget_info(adapter->group, &info) < 0) {
+                throw std::runtime_error("HDF5: failed to query attributes group");
+            }
+            for (; position < info.nlinks && out.size() < chunkSize; ++position) {
+                ssize_t length = H5Lget_name_by_idx(adapter->group, ".", H5_INDEX_NAME, H5_ITER_INC, position,
+                                                    nullptr, 0, H5P_DEFAULT);
+                if (length < 0) {
+                    throw std::runtime_error("HDF5: failed to list datasets");
+                }
+                std::string name(static_cast<std::size_t>(length) + 1, '\0');
+                H5Lget_name_by_idx(adapter->group, ".", H5_INDEX_NAME, H5_ITER_INC, position, &name[0], name.size(),
+                                   H5P_DEFAULT);
+                name.resize(static_cast<std::size_t>(length));
+                std::string key = fromDatasetName(name);
+                if (matchesPrefix(key)) {
+                    std::string value = adapter->readDataset(key);
+                    out.emplace_back(std::move(key), std::move(value));
+                }
+            }
+            return position < info.nlinks;
+        }
+
+    public:
+        ScanCursor(HDF5StorageAdapter* adapter, const std::string& prefix, std::size_t chunkSize)
+            : ChunkedStorageCursor(prefix, chunkSize), adapter(adapter) {}
+    };
+
+public:
+    explicit HDF5StorageAdapter(const std::string& filePath = "archinote.h5", std::size_t batchSize = 256,
+                                unsigned compressionLevel = 6, hsize_t chunkSize = 4096,
+                                std::size_t maxPendingBytes = 4 * 1024 * 1024)
+        : batchSize(std::max<std::size_t>(1, batchSize)), maxPendingBytes(maxPendingBytes),
+          compressionLevel(std::min(compressionLevel, 9u)), chunkSize(std::max<hsize_t>(1, chunkSize)) {
+        if (std::ifstream(filePath).good()) {
+            if (H5Fis_hdf5(filePath.c_str()) <= 0) {
+                throw std::runtime_error("HDF5: not an HDF5 file: " + filePath);
+            }
+            file = H5Fopen(filePath.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+        } else {
+            file = H5Fcreate(filePath.c_str(), H5F_ACC_EXCL, H5P_DEFAULT, H5P_DEFAULT);
+        }
+        if (file < 0) {
+            throw std::runtime_error("HDF5: failed to open file: " + filePath);
+        }
+        if (H5Lexists(file, "attributes", H5P_DEFAULT) > 0) {
+            group = H5Gopen2(file, "attributes", H5P_DEFAULT);
+        } else {
+            group = H5Gcreate2(file, "attributes", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+        }
+        if (group < 0) {
+            H5Fclose(file);
+            throw std::runtime_error("HDF5: failed to open attributes group in: " + filePath);
+        }
+    }
+
+    ~HDF5StorageAdapter() override {
+        try {
+            flush();
+        } catch (const std::exception& e) {
+            std::cerr << "HDF5StorageAdapter: flush on close failed: " << e.what() << std::endl;
+        }
+        H5Gclose(group);
+        H5Fclose(file);
+    }
+
+    // No copy (owns HDF5 handles)
+    HDF5StorageAdapter(const HDF5StorageAdapter&) = delete;
+    HDF5StorageAdapter& operator=(const HDF5StorageAdapter&) = delete;
+
+    void save(const std::string& key, const std::string& data) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        bufferWrite(key, data);
+        flushIfNeeded();
+    }
+
+    std::string load(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = pendingWrites.find(key);
+        if (it != pendingWrites.end()) {
+            return it->second;  // Read-your-writes from the batch buffer
+        }
+        if (pendingRemovals.count(key)) {
+            return "";
+        }
+        return readDataset(key);
+    }
+
+    void remove(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        bufferRemoval(key);
+        flushIfNeeded();
+    }
+
+    // Batches bypass the thresholds: buffer everything, then write it with a single flush
+    void saveBatch(const std::vector<std::string>& keys, const std::vector<std::string>& values) override {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("saveBatch: keys and values differ in length");
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            bufferWrite(keys[i], values[i]);
+        }
+        flushLocked();
+    }
+
+    void removeMany(const std::vector<std::string>& keys) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& key : keys) {
+            bufferRemoval(key);
+        }
+        flushLocked();
+    }
+
+    RawPtrWrapper<IStorageCursor> scan(const std::string& prefix = "") override {
+        RawPtrWrapper<IStorageCursor> cursor(new ScanCursor(this, prefix, batchSize));
+        return RawPtrWrapper<IStorageCursor>(new LockedStorageCursor(std::move(cursor), mutex));
+    }
+
+    bool supportsScan() const override { return true; }
+
+    // Apply all buffered operations and flush HDF5 metadata/raw data caches to disk
+    void flush() override {
+        std::lock_guard<std::mutex> lock(mutex);
+        flushLocked();
+    }
+};
+
+#else
+
+// Example HDF5 storage adapter (placeholder, built without HAS_HDF5)
 class HDF5StorageAdapter : public IStorageAdapter {
 public:
     void save(const std::string& key, const std::string& data) override {
@@ -36,7 +368,9 @@ public:
     }
 };
 
+#endif // HAS_HDF5
+
 
 
 
-#endif //  __HDF5STORAGEADAPTER_HPP__
\ No newline at end of file
+#endif //  __HDF5STORAGEADAPTER_HPP__
@@ -11,9 +11,12 @@ class IArchiNoteManager;
 #include <memory>
 #include <sstream>
 #include <functional>
+#include <stdexcept>
 
 
 #include "../Enums/ArchiNoteType.hpp"
+#include "../RAIIStylePointer.hpp"
+#include "IStorageCursor.hpp"
 
 // Interface for storage adapter
 class IStorageAdapter {
@@ -22,6 +25,41 @@ public:
     virtual void save(const std::string& key, const std::string& data) = 0;
     virtual std::string load(const std::string& key) = 0;
     virtual void remove(const std::string& key) = 0;
+
+    // Batch operations: keys[i] pairs with values[i]. The defaults fall back to one call per key;
+    // adapters override them to reach the backend in a single round trip.
+    virtual void saveBatch(const std::vector<std::string>& keys, const std::vector<std::string>& values) {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("saveBatch: keys and values differ in length");
+        }
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            save(keys[i], values[i]);
+        }
+    }
+    virtual std::vector<std::string> loadMany(const std::vector<std::string>& keys) {
+        std::vector<std::string> values;
+        values.reserve(keys.size());
+        for (const auto& key : keys) {
+            values.push_back(load(key));  // "" for missing keys, as load()
+        }
+        return values;
+    }
+    virtual void removeMany(const std::vector<std::string>& keys) {
+        for (const auto& key : keys) {
+            remove(key);
+        }
+    }
+
+    // Stream every stored pair whose key starts with `prefix` ("" scans everything).
+    // Adapters that cannot enumerate their keys keep this default and supportsScan() == false.
+    virtual RawPtrWrapper<IStorageCursor> scan(const std::string& prefix = "") {
+        (void)prefix;
+        throw std::runtime_error("scan: storage adapter does not support enumeration");
+    }
+    virtual bool supportsScan() const { return false; }
+
+    // Push buffered writes to the backend (no-op for unbuffered adapters)
+    virtual void flush() {}
 };
 
 
@@ -0,0 +1,86 @@
+#ifndef __ISTORAGECURSOR_HPP__
+#define __ISTORAGECURSOR_HPP__
+
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <mutex>
+
+#include "../RAIIStylePointer.hpp"
+
+
+
+
+// Forward-only cursor over the key/value pairs returned by IStorageAdapter::scan()
+// A cursor borrows its adapter and must not outlive it. Writes made while a scan is open may or
+// may not be visible to it.
+class IStorageCursor {
+public:
+    virtual ~IStorageCursor() = default;
+
+    // Fetch the next pair; returns false once the scan is exhausted
+    virtual bool next(std::string& key, std::string& value) = 0;
+};
+
+// Cursor base that pulls pairs from the backend a chunk at a time, so memory stays bounded by
+// chunkSize records no matter how many keys match.
+class ChunkedStorageCursor : public IStorageCursor {
+private:
+    std::vector<std::pair<std::string, std::string>> chunk;
+    std::size_t position = 0;
+    bool exhausted = false;
+
+protected:
+    std::string prefix;
+    std::size_t chunkSize;
+
+    // Append the pairs that follow the previous chunk (at most chunkSize, possibly none);
+    // return false once the backend has nothing further
+    virtual bool fetchChunk(std::vector<std::pair<std::string, std::string>>& out) = 0;
+
+    bool matchesPrefix(const std::string& key) const {
+        return key.compare(0, prefix.size(), prefix) == 0;
+    }
+
+public:
+    ChunkedStorageCursor(const std::string& prefix, std::size_t chunkSize)
+        : prefix(prefix), chunkSize(std::max<std::size_t>(1, chunkSize)) {}
+
+    bool next(std::string& key, std::string& value) override {
+        while (position == chunk.size()) {
+            if (exhausted) {
+                return false;
+            }
+            chunk.clear();
+            position = 0;
+            exhausted = !fetchChunk(chunk);
+        }
+        key = std::move(chunk[position].first);
+        value = std::move(chunk[position].second);
+        ++position;
+        return true;
+    }
+};
+
+// Cursor wrapper for decorators: each step holds the lock that serialises the wrapped adapter
+class LockedStorageCursor : public IStorageCursor {
+private:
+    RawPtrWrapper<IStorageCursor> cursor;
+    std::mutex& mutex;
+
+public:
+    LockedStorageCursor(RawPtrWrapper<IStorageCursor> cursor, std::mutex& mutex)
+        : cursor(std::move(cursor)), mutex(mutex) {}
+
+    bool next(std::string& key, std::string& value) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        return cursor->next(key, value);
+    }
+};
+
+
+
+
+#endif // __ISTORAGECURSOR_HPP__
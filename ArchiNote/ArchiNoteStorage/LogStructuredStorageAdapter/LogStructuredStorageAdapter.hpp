@@ -0,0 +1,670 @@
+#ifndef __LOGSTRUCTUREDSTORAGEADAPTER_HPP__
+#define __LOGSTRUCTUREDSTORAGEADAPTER_HPP__
+
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <memory>
+#include <sstream>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "../IStorageAdapter.hpp"
+
+
+
+
+// Append-only, log-structured storage adapter
+// Every save()/remove() is one sequential append to the active segment file; an in-memory
+// key -> (segment, offset) index makes load() a single pread. Full segments are sealed with a
+// footer (a copy of their index) so startup reads footers instead of rescanning records, and a
+// background thread merges sealed segments, keeping only the live record for each key.
+// Records and footers carry a CRC-32: a footer is only trusted if its magic and CRC match, and a
+// segment without one is replayed record by record up to the first record that fails its CRC
+// (a torn append or a torn footer), where the file is truncated.
+//
+// Record:  [u32 crc][u32 keyLen][u32 valueLen][u8 flags][key][value]     (crc of everything after it)
+// Footer:  [u32 keyLen][u32 valueLen][u64 valueOffset][u8 flags][key] * N
+//          [u64 footerOffset][u64 N][u64 crc][u64 magic]                   (crc of the footer up to it)
+class LogStructuredStorageAdapter : public IStorageAdapter {
+private:
+    static constexpr std::uint64_t FOOTER_MAGIC = 0x41524348494C4F47ULL;  // "ARCHILOG"
+    static constexpr std::size_t RECORD_HEADER_SIZE = 13;
+    static constexpr std::size_t FOOTER_ENTRY_HEADER_SIZE = 17;
+    static constexpr std::size_t TRAILER_SIZE = 32;
+    static constexpr std::uint8_t FLAG_TOMBSTONE = 1;
+
+    struct Location {
+        std::uint64_t segment = 0;
+        std::uint64_t valueOffset = 0;
+        std::uint32_t valueLen = 0;
+        bool tombstone = false;
+
+        bool operator==(const Location& other) const {
+            return segment == other.segment && valueOffset == other.valueOffset &&
+                   valueLen == other.valueLen && tombstone == other.tombstone;
+        }
+    };
+
+    std::string directory;
+    std::uint64_t maxSegmentBytes;  // Seal the active segment once it grows past this
+    std::size_t compactionThreshold;  // Compact once this many sealed segments exist
+
+    mutable std::mutex mutex;  // Guards everything below
+    std::map<std::string, Location> index;  // Latest location per key (tombstones kept until compacted away)
+    std::map<std::uint64_t, int> segmentFds;  // Open descriptors, sealed + active
+    std::set<std::uint64_t> sealedSegments;
+    std::uint64_t activeSegment = 0;
+    std::uint64_t activeSize = 0;
+    std::map<std::string, Location> activeEntries;  // Becomes the active segment's footer on seal
+
+    std::thread compactionThread;
+    std::condition_variable compactionWakeup;
+    bool stopping = false;
+
+    // Helpers: fixed-width little-endian encoding (host order on supported platforms)
+    template <typename T>
+    static void appendRaw(std::string& buffer, T value) {
+        buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+    template <typename T>
+    static T readRaw(const char* data) {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+        return value;
+    }
+
+    // CRC-32 (IEEE, reflected), continuing from `crc`
+    static std::uint32_t crc32(const char* data, std::size_t length, std::uint32_t crc = 0) {
+        static const std::vector<std::uint32_t> table = [] {
+            std::vector<std::uint32_t> entries(256);
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                std::uint32_t value = i;
+                for (int bit = 0; bit < 8; ++bit) {
+                    value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+                }
+                entries[i] = value;
+            }
+            return entries;
+        }();
+        crc = ~crc;
+        for (std::size_t i = 0; i < length; ++i) {
+            crc = table[(crc ^ static_cast<unsigned char>(data[i])) & 0xff] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    static void syncFully(int fd, const std::string& path) {
+        while (::fdatasync(fd) != 0) {
+            if (errno != EINTR) {
+                throw std::runtime_error("LogStructuredStorageAdapter: fdatasync failed on " + path + ": " +
+                                         std::strerror(errno));
+            }
+        }
+    }
+
+    // Lengths are stored as u32
+    static void requireEncodable(const std::string& key, const std::string& value) {
+        if (key.size() > std::numeric_limits<std::uint32_t>::max() ||
+            value.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::invalid_argument("LogStructuredStorageAdapter: key or value larger than 4 GiB: " +
+                                        key.substr(0, 64));
+        }
+    }
+
+    std::string segmentPath(std::uint64_t segment, const char* suffix = ".log") const {
+        char name[40];
+        std::snprintf(name, sizeof(name), "segment-%010llu", static_cast<unsigned long long>(segment));
+        return directory + "/" + name + suffix;
+    }
+
+    static void preadFully(int fd, char* out, std::size_t length, std::uint64_t offset) {
+        while (length > 0) {
+            ssize_t n = ::pread(fd, out, length, static_cast<off_t>(offset));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                throw std::runtime_error("LogStructuredStorageAdapter: short read");
+            }
+            out += n;
+            length -= static_cast<std::size_t>(n);
+            offset += static_cast<std::uint64_t>(n);
+        }
+    }
+
+    static void pwriteFully(int fd, const std::string& buffer, std::uint64_t offset) {
+        const char* data = buffer.data();
+        std::size_t length = buffer.size();
+        while (length > 0) {
+            ssize_t n = ::pwrite(fd, data, length, static_cast<off_t>(offset));
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                throw std::runtime_error("LogStructuredStorageAdapter: write failed");
+            }
+            data += n;
+            length -= static_cast<std::size_t>(n);
+            offset += static_cast<std::uint64_t>(n);
+        }
+    }
+
+    static void encodeRecord(std::string& buffer, const std::string& key, const std::string& value, bool tombstone) {
+        std::size_t start = buffer.size();
+        appendRaw<std::uint32_t>(buffer, 0);  // CRC, filled in below
+        appendRaw<std::uint32_t>(buffer, static_cast<std::uint32_t>(key.size()));
+        appendRaw<std::uint32_t>(buffer, static_cast<std::uint32_t>(value.size()));
+        appendRaw<std::uint8_t>(buffer, tombstone ? FLAG_TOMBSTONE : 0);
+        buffer += key;
+        buffer += value;
+        std::uint32_t crc = crc32(buffer.data() + start + 4, buffer.size() - start - 4);
+        std::memcpy(&buffer[start], &crc, sizeof(crc));
+    }
+
+    static void encodeFooter(std::string& buffer, const std::map<std::string, Location>& entries,
+                             std::uint64_t footerOffset) {
+        std::size_t start = buffer.size();
+        for (const auto& pair : entries) {
+            appendRaw<std::uint32_t>(buffer, static_cast<std::uint32_t>(pair.first.size()));
+            appendRaw<std::uint32_t>(buffer, pair.second.valueLen);
+            appendRaw<std::uint64_t>(buffer, pair.second.valueOffset);
+            appendRaw<std::uint8_t>(buffer, pair.second.tombstone ? FLAG_TOMBSTONE : 0);
+            buffer += pair.first;
+        }
+        appendRaw<std::uint64_t>(buffer, footerOffset);
+        appendRaw<std::uint64_t>(buffer, static_cast<std::uint64_t>(entries.size()));
+        appendRaw<std::uint64_t>(buffer, crc32(buffer.data() + start, buffer.size() - start));
+        appendRaw<std::uint64_t>(buffer, FOOTER_MAGIC);
+    }
+
+    int openSegment(std::uint64_t segment, int flags) const {
+        int fd = ::open(segmentPath(segment).c_str(), flags, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("LogStructuredStorageAdapter: cannot open " + segmentPath(segment));
+        }
+        return fd;
+    }
+
+    // Startup: a sealed segment contributes its footer; returns false if it has no intact one
+    bool loadFooter(std::uint64_t segment, int fd, std::uint64_t fileSize) {
+        if (fileSize < TRAILER_SIZE) {
+            return false;
+        }
+        char trailer[TRAILER_SIZE];
+        preadFully(fd, trailer, TRAILER_SIZE, fileSize - TRAILER_SIZE);
+        std::uint64_t footerOffset = readRaw<std::uint64_t>(trailer);
+        std::uint64_t count = readRaw<std::uint64_t>(trailer + 8);
+        if (readRaw<std::uint64_t>(trailer + 24) != FOOTER_MAGIC || footerOffset > fileSize - TRAILER_SIZE) {
+            return false;
+        }
+        std::string footer(static_cast<std::size_t>(fileSize - TRAILER_SIZE - footerOffset), '\0');
+        if (!footer.empty()) {
+            preadFully(fd, &footer[0], footer.size(), footerOffset);
+        }
+        std::uint32_t crc = crc32(trailer, 16, crc32(footer.data(), footer.size()));
+        if (readRaw<std::uint64_t>(trailer + 16) != crc) {
+            return false;  // Torn or corrupt footer: replay the records instead
+        }
+        std::size_t pos = 0;
+        for (std::uint64_t i = 0; i < count; ++i) {
+            if (pos + FOOTER_ENTRY_HEADER_SIZE > footer.size()) {
+                throw std::runtime_error("LogStructuredStorageAdapter: corrupt footer in " + segmentPath(segment));
+            }
+            std::uint32_t keyLen = readRaw<std::uint32_t>(&footer[pos]);
+            Location loc;
+            loc.segment = segment;
+            loc.valueLen = readRaw<std::uint32_t>(&footer[pos + 4]);
+            loc.valueOffset = readRaw<std::uint64_t>(&footer[pos + 8]);
+            loc.tombstone = (footer[pos + 16] & FLAG_TOMBSTONE) != 0;
+            pos += FOOTER_ENTRY_HEADER_SIZE;
+            if (pos + keyLen > footer.size()) {
+                throw std::runtime_error("LogStructuredStorageAdapter: corrupt footer in " + segmentPath(segment));
+            }
+            index[footer.substr(pos, keyLen)] = loc;
+            pos += keyLen;
+        }
+        return true;
+    }
+
+    // Startup: a segment without an intact footer (the active one at shutdown/crash) is replayed
+    // record by record. Everything from the first record that is cut short or fails its CRC on is
+    // truncated away: a torn append, or a torn footer. Returns the valid length.
+    std::uint64_t scanSegment(std::uint64_t segment, int fd, std::uint64_t fileSize,
+                              std::map<std::string, Location>& entries) {
+        std::uint64_t offset = 0;
+        char header[RECORD_HEADER_SIZE];
+        std::string body;
+        while (offset + RECORD_HEADER_SIZE <= fileSize) {
+            preadFully(fd, header, RECORD_HEADER_SIZE, offset);
+            std::uint32_t keyLen = readRaw<std::uint32_t>(header + 4);
+            std::uint32_t valueLen = readRaw<std::uint32_t>(header + 8);
+            std::uint64_t end = offset + RECORD_HEADER_SIZE + keyLen + valueLen;
+            if (end > fileSize) {
+                break;
+            }
+            body.assign(static_cast<std::size_t>(keyLen) + valueLen, '\0');
+            if (!body.empty()) {
+                preadFully(fd, &body[0], body.size(), offset + RECORD_HEADER_SIZE);
+            }
+            if (crc32(body.data(), body.size(), crc32(header + 4, RECORD_HEADER_SIZE - 4)) !=
+                readRaw<std::uint32_t>(header)) {
+                break;
+            }
+            Location loc;
+            loc.segment = segment;
+            loc.valueOffset = offset + RECORD_HEADER_SIZE + keyLen;
+            loc.valueLen = valueLen;
+            loc.tombstone = (header[12] & FLAG_TOMBSTONE) != 0;
+            std::string key = body.substr(0, keyLen);
+            index[key] = loc;
+            entries[key] = loc;
+            offset = end;
+        }
+        if (offset < fileSize && ::ftruncate(fd, static_cast<off_t>(offset)) != 0) {
+            throw std::runtime_error("LogStructuredStorageAdapter: cannot truncate " + segmentPath(segment));
+        }
+        return offset;
+    }
+
+    void openDirectory() {
+        if (::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+            throw std::runtime_error("LogStructuredStorageAdapter: cannot create directory " + directory);
+        }
+        std::vector<std::uint64_t> segments;
+        DIR* dir = ::opendir(directory.c_str());
+        if (!dir) {
+            throw std::runtime_error("LogStructuredStorageAdapter: cannot open directory " + directory);
+        }
+        while (dirent* entry = ::readdir(dir)) {
+            unsigned long long segment = 0;
+            char tail[8] = {0};
+            if (std::sscanf(entry->d_name, "segment-%llu%7s", &segment, tail) == 2 && std::strcmp(tail, ".log") == 0) {
+                segments.push_back(segment);
+            } else if (std::strstr(entry->d_name, ".compact")) {
+                ::unlink((directory + "/" + entry->d_name).c_str());  // Interrupted compaction
+            }
+        }
+        ::closedir(dir);
+        std::sort(segments.begin(), segments.end());
+
+        // Replay in segment order: later segments override earlier ones
+        for (std::size_t i = 0; i < segments.size(); ++i) {
+            std::uint64_t segment = segments[i];
+            int fd = openSegment(segment, O_RDWR);
+            segmentFds[segment] = fd;
+            struct stat st;
+            if (::fstat(fd, &st) != 0) {
+                throw std::runtime_error("LogStructuredStorageAdapter: cannot stat " + segmentPath(segment));
+            }
+            std::uint64_t fileSize = static_cast<std::uint64_t>(st.st_size);
+            if (loadFooter(segment, fd, fileSize)) {
+                sealedSegments.insert(segment);
+            } else if (i + 1 == segments.size()) {
+                activeSegment = segment;
+                activeSize = scanSegment(segment, fd, fileSize, activeEntries);
+            } else {
+                // An older segment whose footer was torn: replay it and seal it again
+                std::map<std::string, Location> entries;
+                std::uint64_t size = scanSegment(segment, fd, fileSize, entries);
+                std::string footer;
+                encodeFooter(footer, entries, size);
+                pwriteFully(fd, footer, size);
+                syncFully(fd, segmentPath(segment));
+                sealedSegments.insert(segment);
+            }
+        }
+        if (segmentFds.empty() || sealedSegments.count(segments.back())) {
+            activeSegment = segments.empty() ? 1 : segments.back() + 1;
+            activeSize = 0;
+            segmentFds[activeSegment] = openSegment(activeSegment, O_RDWR | O_CREAT | O_TRUNC);
+        }
+    }
+
+    // Caller holds the mutex
+    void sealActiveSegment() {
+        std::string footer;
+        encodeFooter(footer, activeEntries, activeSize);
+        int fd = segmentFds[activeSegment];
+        pwriteFully(fd, footer, activeSize);
+        syncFully(fd, segmentPath(activeSegment));
+        sealedSegments.insert(activeSegment);
+        activeEntries.clear();
+        activeSegment += 1;
+        activeSize = 0;
+        segmentFds[activeSegment] = openSegment(activeSegment, O_RDWR | O_CREAT | O_TRUNC);
+        if (sealedSegments.size() >= compactionThreshold) {
+            compactionWakeup.notify_one();
+        }
+    }
+
+    // Caller holds the mutex. Appends all records with a single write; values[i] pairs with keys[i]
+    // (values may be null for tombstones).
+    void appendBatch(const std::vector<std::string>& keys, const std::vector<std::string>* values, bool tombstone) {
+        static const std::string empty;
+        std::string buffer;
+        std::vector<Location> locations;
+        locations.reserve(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            requireEncodable(keys[i], values ? (*values)[i] : empty);
+        }
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            const std::string& value = values ? (*values)[i] : empty;
+            Location loc;
+            loc.segment = activeSegment;
+            loc.valueOffset = activeSize + buffer.size() + RECORD_HEADER_SIZE + keys[i].size();
+            loc.valueLen = static_cast<std::uint32_t>(value.size());
+            loc.tombstone = tombstone;
+            locations.push_back(loc);
+            encodeRecord(buffer, keys[i], value, tombstone);
+        }
+        pwriteFully(segmentFds[activeSegment], buffer, activeSize);
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            index[keys[i]] = locations[i];
+            activeEntries[keys[i]] = locations[i];
+        }
+        activeSize += buffer.size();
+        if (activeSize >= maxSegmentBytes) {
+            sealActiveSegment();
+        }
+    }
+
+    // Caller holds the mutex
+    void append(const std::string& key, const std::string& value, bool tombstone) {
+        std::vector<std::string> keys(1, key);
+        std::vector<std::string> values(1, value);
+        appendBatch(keys, &values, tombstone);
+    }
+
+    // Merge all sealed segments into one, written under the newest input's id so replay order holds.
+    // Sealed segments are immutable, so values are copied without holding the mutex.
+    void compactSealedSegments() {
+        std::vector<std::pair<std::string, Location>> live;
+        std::set<std::uint64_t> inputs;
+        std::map<std::uint64_t, int> inputFds;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (sealedSegments.size() < compactionThreshold) {
+                return;
+            }
+            inputs = sealedSegments;
+            for (std::uint64_t segment : inputs) {
+                inputFds[segment] = segmentFds[segment];
+            }
+            for (const auto& pair : index) {
+                if (inputs.count(pair.second.segment)) {
+                    live.push_back(pair);
+                }
+            }
+        }
+        std::uint64_t oldest = *inputs.begin();
+        std::uint64_t output = *inputs.rbegin();
+
+        // A tombstone only has to survive while an older segment could still hold the key
+        std::map<std::string, Location> outputEntries;
+        std::string tempPath = segmentPath(output, ".compact");
+        int fd = ::open(tempPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("LogStructuredStorageAdapter: cannot create " + tempPath);
+        }
+        std::uint64_t size = 0;
+        std::string buffer;
+        std::string value;
+        try {
+            for (const auto& pair : live) {
+                const Location& loc = pair.second;
+                if (loc.tombstone && loc.segment == oldest) {
+                    continue;
+                }
+                value.assign(loc.valueLen, '\0');
+                if (loc.valueLen > 0) {
+                    preadFully(inputFds[loc.segment], &value[0], loc.valueLen, loc.valueOffset);
+                }
+                Location moved = loc;
+                moved.segment = output;
+                moved.valueOffset = size + buffer.size() + RECORD_HEADER_SIZE + pair.first.size();
+                outputEntries[pair.first] = moved;
+                encodeRecord(buffer, pair.first, value, loc.tombstone);
+                if (buffer.size() >= (1u << 20)) {
+                    pwriteFully(fd, buffer, size);
+                    size += buffer.size();
+                    buffer.clear();
+                }
+            }
+            std::uint64_t footerOffset = size + buffer.size();
+            encodeFooter(buffer, outputEntries, footerOffset);
+            pwriteFully(fd, buffer, size);
+            syncFully(fd, tempPath);
+            if (::rename(tempPath.c_str(), segmentPath(output).c_str()) != 0) {
+                throw std::runtime_error("LogStructuredStorageAdapter: cannot install compacted segment");
+            }
+        } catch (...) {
+            ::close(fd);
+            ::unlink(tempPath.c_str());
+            throw;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& pair : live) {
+            auto it = index.find(pair.first);
+            if (it == index.end() || !(it->second == pair.second)) {
+                continue;  // Overwritten in the active segment while we were copying
+            }
+            auto moved = outputEntries.find(pair.first);
+            if (moved == outputEntries.end()) {
+                index.erase(it);  // Dropped tombstone
+            } else {
+                it->second = moved->second;
+            }
+        }
+        for (std::uint64_t segment : inputs) {
+            ::close(segmentFds[segment]);
+            segmentFds.erase(segment);
+            sealedSegments.erase(segment);
+            if (segment != output) {
+                ::unlink(segmentPath(segment).c_str());
+            }
+        }
+        segmentFds[output] = fd;
+        sealedSegments.insert(output);
+    }
+
+    void compactionLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            compactionWakeup.wait(lock, [this] { return stopping || sealedSegments.size() >= compactionThreshold; });
+            if (stopping) {
+                break;
+            }
+            lock.unlock();
+            try {
+                compactSealedSegments();
+            } catch (const std::exception& e) {
+                std::cerr << "LogStructuredStorageAdapter: compaction failed: " << e.what() << std::endl;
+            }
+            lock.lock();
+            if (!stopping && sealedSegments.size() >= compactionThreshold) {
+                // Compaction failed and left the inputs in place; don't spin on it
+                compactionWakeup.wait_for(lock, std::chrono::seconds(1));
+            }
+        }
+    }
+
+    // Walks the ordered index from the prefix; each chunk is read under one lock acquisition
+    class ScanCursor : public ChunkedStorageCursor {
+    private:
+        LogStructuredStorageAdapter* adapter;
+        std::string resumeKey;  // Last key returned; the next chunk starts strictly after it
+        bool started = false;
+
+    protected:
+        bool fetchChunk(std::vector<std::pair<std::string, std::string>>& out) override {
+            std::lock_guard<std::mutex> lock(adapter->mutex);
+            auto it = started ? adapter->index.upper_bound(resumeKey) : adapter->index.lower_bound(prefix);
+            started = true;
+            for (; it != adapter->index.end() && out.size() < chunkSize; ++it) {
+                if (!matchesPrefix(it->first)) {
+                    return false;  // Ordered index: past the prefix range
+                }
+                resumeKey = it->first;
+                if (it->second.tombstone) {
+                    continue;
+                }
+                std::string value(it->second.valueLen, '\0');
+                if (!value.empty()) {
+                    adapter->preadFully(adapter->segmentFds[it->second.segment], &value[0], value.size(),
+                                        it->second.valueOffset);
+                }
+                out.emplace_back(it->first, std::move(value));
+            }
+            return it != adapter->index.end();
+        }
+
+    public:
+        ScanCursor(LogStructuredStorageAdapter* adapter, const std::string& prefix, std::size_t chunkSize)
+            : ChunkedStorageCursor(prefix, chunkSize), adapter(adapter) {}
+    };
+
+public:
+    explicit LogStructuredStorageAdapter(const std::string& directory = "archinote.log",
+                                         std::uint64_t maxSegmentBytes = 16 * 1024 * 1024,
+                                         std::size_t compactionThreshold = 4)
+        : directory(directory), maxSegmentBytes(std::max<std::uint64_t>(1, maxSegmentBytes)),
+          compactionThreshold(std::max<std::size_t>(2, compactionThreshold)) {
+        try {
+            openDirectory();
+            compactionThread = std::thread(&LogStructuredStorageAdapter::compactionLoop, this);
+        } catch (...) {
+            // The destructor does not run for a half-built object: close what openDirectory() opened
+            for (auto& pair : segmentFds) {
+                ::close(pair.second);
+            }
+            throw;
+        }
+    }
+
+    ~LogStructuredStorageAdapter() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        compactionWakeup.notify_one();
+        compactionThread.join();
+        std::lock_guard<std::mutex> lock(mutex);
+        try {
+            if (activeSize > 0) {
+                // Seal on close so the next startup only reads footers
+                std::string footer;
+                encodeFooter(footer, activeEntries, activeSize);
+                pwriteFully(segmentFds[activeSegment], footer, activeSize);
+                syncFully(segmentFds[activeSegment], segmentPath(activeSegment));
+            }
+        } catch (const std::exception& e) {
+            std::cerr << "LogStructuredStorageAdapter: seal on close failed: " << e.what() << std::endl;
+        }
+        for (auto& pair : segmentFds) {
+            ::close(pair.second);
+        }
+        if (activeSize == 0) {
+            ::unlink(segmentPath(activeSegment).c_str());
+        }
+    }
+
+    // No copy (owns file descriptors and a background thread)
+    LogStructuredStorageAdapter(const LogStructuredStorageAdapter&) = delete;
+    LogStructuredStorageAdapter& operator=(const LogStructuredStorageAdapter&) = delete;
+
+    void save(const std::string& key, const std::string& data) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        append(key, data, false);
+    }
+
+    std::string load(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it == index.end() || it->second.tombstone) {
+            return "";
+        }
+        std::string data(it->second.valueLen, '\0');
+        if (!data.empty()) {
+            preadFully(segmentFds[it->second.segment], &data[0], data.size(), it->second.valueOffset);
+        }
+        return data;
+    }
+
+    void remove(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(key);
+        if (it == index.end() || it->second.tombstone) {
+            return;  // Nothing to shadow
+        }
+        append(key, "", true);
+    }
+
+    void saveBatch(const std::vector<std::string>& keys, const std::vector<std::string>& values) override {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("saveBatch: keys and values differ in length");
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        appendBatch(keys, &values, false);
+    }
+
+    std::vector<std::string> loadMany(const std::vector<std::string>& keys) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::string> values(keys.size());
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            auto it = index.find(keys[i]);
+            if (it != index.end() && !it->second.tombstone && it->second.valueLen > 0) {
+                values[i].resize(it->second.valueLen);
+                preadFully(segmentFds[it->second.segment], &values[i][0], values[i].size(), it->second.valueOffset);
+            }
+        }
+        return values;
+    }
+
+    void removeMany(const std::vector<std::string>& keys) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::string> live;
+        for (const auto& key : keys) {
+            auto it = index.find(key);
+            if (it != index.end() && !it->second.tombstone) {
+                live.push_back(key);
+            }
+        }
+        if (!live.empty()) {
+            appendBatch(live, nullptr, true);
+        }
+    }
+
+    RawPtrWrapper<IStorageCursor> scan(const std::string& prefix = "") override {
+        return RawPtrWrapper<IStorageCursor>(new ScanCursor(this, prefix, 256));
+    }
+
+    bool supportsScan() const override { return true; }
+
+    // Appends are not fsync'd individually; flush() makes everything written so far durable
+    void flush() override {
+        std::lock_guard<std::mutex> lock(mutex);
+        syncFully(segmentFds[activeSegment], segmentPath(activeSegment));
+    }
+};
+
+
+
+
+#endif // __LOGSTRUCTUREDSTORAGEADAPTER_HPP__
@@ -0,0 +1,493 @@
+#ifndef __MEMORYMAPPEDSTORAGEADAPTER_HPP__
+#define __MEMORYMAPPEDSTORAGEADAPTER_HPP__
+
+
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <mutex>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "../IStorageAdapter.hpp"
+
+
+
+
+// Memory-mapped storage adapter
+// All keys and values live in one mapped file. An on-disk open-addressing (linear probing) hash
+// table maps keys to their records, so load() is one hash probe plus a memcpy, and loadView()
+// skips the copy entirely. Records are appended; an overwrite that fits reuses the old slot.
+//
+// File:    [Header][... records (key bytes, value bytes) ... | bucket table ...]
+// The bucket table is relocated to the end of the data region whenever it grows.
+// Removed and relocated records and superseded tables leave dead bytes behind. Once they reach
+// MIN_COMPACT_BYTES and outweigh the live bytes, the live records are copied into a fresh file
+// that replaces this one (compact() does the same on demand).
+// The IStorageAdapter calls are serialised by one mutex; loadView() and size() are not, and must not
+// race with writers.
+class MemoryMappedStorageAdapter : public IStorageAdapter {
+private:
+    static constexpr std::uint64_t FILE_MAGIC = 0x41524348494D4D41ULL;  // "ARCHIMMA"
+    static constexpr std::uint32_t FILE_VERSION = 1;
+    static constexpr std::uint64_t INITIAL_BUCKETS = 1024;  // Power of two
+    static constexpr std::uint64_t INITIAL_FILE_SIZE = 1024 * 1024;
+    static constexpr std::uint64_t MIN_COMPACT_BYTES = 1024 * 1024;
+
+    enum BucketState : std::uint32_t { EMPTY = 0, LIVE = 1, DELETED = 2 };
+
+    struct Header {
+        std::uint64_t magic;
+        std::uint32_t version;
+        std::uint32_t reserved;
+        std::uint64_t tableOffset;
+        std::uint64_t bucketCount;
+        std::uint64_t usedBuckets;  // LIVE + DELETED (both lengthen probe chains)
+        std::uint64_t liveCount;
+        std::uint64_t dataEnd;  // First free byte
+    };
+
+    struct Bucket {
+        std::uint64_t hash;
+        std::uint64_t offset;  // Key bytes, immediately followed by value bytes
+        std::uint32_t keyLen;
+        std::uint32_t valueLen;
+        std::uint32_t state;
+        std::uint32_t capacity;  // Value bytes reserved at offset + keyLen (>= valueLen)
+    };
+
+    std::mutex mutex;  // Serialises the IStorageAdapter calls
+    std::string filePath;
+    int fd = -1;
+    char* base = nullptr;
+    std::uint64_t mappedSize = 0;
+    std::uint64_t liveBytes = 0;  // Header, current table and live records; the rest of dataEnd is dead
+
+    Header* header() const { return reinterpret_cast<Header*>(base); }
+    Bucket* table() const { return reinterpret_cast<Bucket*>(base + header()->tableOffset); }
+
+    // FNV-1a: part of the file format, must stay stable across builds
+    static std::uint64_t hashKey(const char* data, std::size_t length) {
+        std::uint64_t hash = 0xcbf29ce484222325ULL;
+        for (std::size_t i = 0; i < length; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+    static std::uint64_t alignUp(std::uint64_t value) {
+        return (value + 7) & ~std::uint64_t(7);
+    }
+
+    // Lengths are stored as u32
+    static void requireEncodable(const std::string& key, const std::string& data) {
+        if (key.size() > std::numeric_limits<std::uint32_t>::max() ||
+            data.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::invalid_argument("MemoryMappedStorageAdapter: key or value larger than 4 GiB: " +
+                                        key.substr(0, 64));
+        }
+    }
+
+    static std::uint64_t recordBytes(const Bucket& bucket) {
+        return static_cast<std::uint64_t>(bucket.keyLen) + bucket.capacity;
+    }
+
+    // Startup: everything but the dead bytes
+    std::uint64_t countLiveBytes() const {
+        std::uint64_t bytes = alignUp(sizeof(Header)) + header()->bucketCount * sizeof(Bucket);
+        const Bucket* buckets = table();
+        for (std::uint64_t i = 0; i < header()->bucketCount; ++i) {
+            if (buckets[i].state == LIVE) {
+                bytes += recordBytes(buckets[i]);
+            }
+        }
+        return bytes;
+    }
+
+    std::uint64_t deadBytes() const {
+        return header()->dataEnd - std::min(liveBytes, header()->dataEnd);
+    }
+
+    // Smallest table (power of two, >= INITIAL_BUCKETS) holding `live` keys at load factor <= 0.5
+    static std::uint64_t bucketsFor(std::uint64_t live) {
+        std::uint64_t count = INITIAL_BUCKETS;
+        while (live * 2 > count) {
+            count *= 2;
+        }
+        return count;
+    }
+
+    void mapFile(std::uint64_t size) {
+        if (base) {
+            ::munmap(base, mappedSize);
+            base = nullptr;
+        }
+        void* mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapped == MAP_FAILED) {
+            throw std::runtime_error("MemoryMappedStorageAdapter: mmap failed");
+        }
+        base = static_cast<char*>(mapped);
+        mappedSize = size;
+    }
+
+    // Grow the file (and remap) so that `bytes` more can be appended at dataEnd.
+    // Invalidates every pointer into the mapping.
+    void reserve(std::uint64_t bytes) {
+        std::uint64_t needed = header()->dataEnd + bytes;
+        if (needed <= mappedSize) {
+            return;
+        }
+        std::uint64_t newSize = std::max(mappedSize * 2, needed);
+        if (::ftruncate(fd, static_cast<off_t>(newSize)) != 0) {
+            throw std::runtime_error("MemoryMappedStorageAdapter: cannot grow file");
+        }
+        mapFile(newSize);
+    }
+
+    // Returns the bucket holding `key`, or the slot to insert it into (first DELETED on the chain,
+    // else the terminating EMPTY). `found` tells the two apart.
+    Bucket* probe(std::string_view key, std::uint64_t hash, bool& found) const {
+        Bucket* buckets = table();
+        std::uint64_t mask = header()->bucketCount - 1;
+        Bucket* reusable = nullptr;
+        for (std::uint64_t i = hash & mask;; i = (i + 1) & mask) {
+            Bucket* bucket = &buckets[i];
+            if (bucket->state == EMPTY) {
+                found = false;
+                return reusable ? reusable : bucket;
+            }
+            if (bucket->state == DELETED) {
+                if (!reusable) reusable = bucket;
+            } else if (bucket->hash == hash && bucket->keyLen == key.size() &&
+                       std::memcmp(base + bucket->offset, key.data(), key.size()) == 0) {
+                found = true;
+                return bucket;
+            }
+        }
+    }
+
+    // Relocate the table to the end of the data region with `newCount` buckets, dropping tombstones
+    void rehash(std::uint64_t newCount) {
+        std::uint64_t tableBytes = newCount * sizeof(Bucket);
+        reserve(alignUp(header()->dataEnd) - header()->dataEnd + tableBytes);
+        std::uint64_t newOffset = alignUp(header()->dataEnd);
+        Bucket* oldBuckets = table();
+        std::uint64_t oldCount = header()->bucketCount;
+        Bucket* newBuckets = reinterpret_cast<Bucket*>(base + newOffset);
+        std::memset(static_cast<void*>(newBuckets), 0, tableBytes);
+        for (std::uint64_t i = 0; i < oldCount; ++i) {
+            if (oldBuckets[i].state != LIVE) continue;
+            std::uint64_t j = oldBuckets[i].hash & (newCount - 1);
+            while (newBuckets[j].state != EMPTY) {
+                j = (j + 1) & (newCount - 1);
+            }
+            newBuckets[j] = oldBuckets[i];
+        }
+        liveBytes = liveBytes - oldCount * sizeof(Bucket) + tableBytes;
+        header()->dataEnd = newOffset + tableBytes;
+        header()->tableOffset = newOffset;
+        header()->bucketCount = newCount;
+        header()->usedBuckets = header()->liveCount;
+    }
+
+    // Caller holds the mutex. Write the live records, packed, and a fresh table into
+    // "<file>.compact", then rename it over the file and map it instead. Invalidates every pointer
+    // into the mapping. The old file stays intact until the rename, so a failure loses nothing.
+    void compactLocked() {
+        std::uint64_t live = header()->liveCount;
+        std::uint64_t bucketCount = bucketsFor(live);
+        std::uint64_t tableOffset = alignUp(sizeof(Header));
+        std::uint64_t dataStart = tableOffset + bucketCount * sizeof(Bucket);
+        std::uint64_t recordTotal = 0;
+        const Bucket* oldBuckets = table();
+        for (std::uint64_t i = 0; i < header()->bucketCount; ++i) {
+            if (oldBuckets[i].state == LIVE) {
+                recordTotal += oldBuckets[i].keyLen + static_cast<std::uint64_t>(oldBuckets[i].valueLen);
+            }
+        }
+        std::uint64_t dataEnd = dataStart + recordTotal;
+        std::uint64_t size = std::max(INITIAL_FILE_SIZE, dataEnd);
+
+        std::string tempPath = filePath + ".compact";
+        int out = ::open(tempPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (out < 0) {
+            throw std::runtime_error("MemoryMappedStorageAdapter: cannot create " + tempPath);
+        }
+        char* mapped = nullptr;
+        try {
+            if (::ftruncate(out, static_cast<off_t>(size)) != 0) {
+                throw std::runtime_error("MemoryMappedStorageAdapter: cannot size " + tempPath);
+            }
+            void* region = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, out, 0);
+            if (region == MAP_FAILED) {
+                throw std::runtime_error("MemoryMappedStorageAdapter: mmap failed on " + tempPath);
+            }
+            mapped = static_cast<char*>(region);
+            Header* h = reinterpret_cast<Header*>(mapped);
+            *h = *header();
+            h->tableOffset = tableOffset;
+            h->bucketCount = bucketCount;
+            h->usedBuckets = live;
+            h->dataEnd = dataEnd;
+            Bucket* newBuckets = reinterpret_cast<Bucket*>(mapped + tableOffset);
+            std::memset(static_cast<void*>(newBuckets), 0, bucketCount * sizeof(Bucket));
+            std::uint64_t cursor = dataStart;
+            for (std::uint64_t i = 0; i < header()->bucketCount; ++i) {
+                if (oldBuckets[i].state != LIVE) continue;
+                Bucket moved = oldBuckets[i];
+                std::uint64_t length = moved.keyLen + static_cast<std::uint64_t>(moved.valueLen);
+                std::memcpy(mapped + cursor, base + moved.offset, length);
+                moved.offset = cursor;
+                moved.capacity = moved.valueLen;
+                cursor += length;
+                std::uint64_t j = moved.hash & (bucketCount - 1);
+                while (newBuckets[j].state != EMPTY) {
+                    j = (j + 1) & (bucketCount - 1);
+                }
+                newBuckets[j] = moved;
+            }
+            if (::msync(mapped, size, MS_SYNC) != 0 || ::fsync(out) != 0) {
+                throw std::runtime_error("MemoryMappedStorageAdapter: cannot sync " + tempPath);
+            }
+            if (::rename(tempPath.c_str(), filePath.c_str()) != 0) {
+                throw std::runtime_error("MemoryMappedStorageAdapter: cannot install compacted file");
+            }
+        } catch (...) {
+            if (mapped) ::munmap(mapped, size);
+            ::close(out);
+            ::unlink(tempPath.c_str());
+            throw;
+        }
+        ::munmap(base, mappedSize);
+        ::close(fd);
+        fd = out;
+        base = mapped;
+        mappedSize = size;
+        liveBytes = dataEnd;
+    }
+
+    // Caller holds the mutex
+    void compactIfNeeded() {
+        std::uint64_t dead = deadBytes();
+        if (dead >= MIN_COMPACT_BYTES && dead >= liveBytes) {
+            compactLocked();
+        }
+    }
+
+    void initialize() {
+        std::uint64_t tableOffset = alignUp(sizeof(Header));
+        std::uint64_t size = std::max(INITIAL_FILE_SIZE, tableOffset + INITIAL_BUCKETS * sizeof(Bucket));
+        if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            throw std::runtime_error("MemoryMappedStorageAdapter: cannot size file");
+        }
+        mapFile(size);
+        Header* h = header();
+        h->magic = FILE_MAGIC;
+        h->version = FILE_VERSION;
+        h->reserved = 0;
+        h->tableOffset = tableOffset;
+        h->bucketCount = INITIAL_BUCKETS;
+        h->usedBuckets = 0;
+        h->liveCount = 0;
+        h->dataEnd = tableOffset + INITIAL_BUCKETS * sizeof(Bucket);
+        std::memset(base + tableOffset, 0, INITIAL_BUCKETS * sizeof(Bucket));
+        liveBytes = h->dataEnd;
+    }
+
+    // Walks the bucket table in slot order (unordered). A save() that grows the table, or a
+    // compaction, while a scan is open reshuffles the slots, so keys may then be repeated or missed.
+    class ScanCursor : public ChunkedStorageCursor {
+    private:
+        const MemoryMappedStorageAdapter* adapter;
+        std::uint64_t slot = 0;
+
+    protected:
+        bool fetchChunk(std::vector<std::pair<std::string, std::string>>& out) override {
+            const Bucket* buckets = adapter->table();  // Re-read: the mapping may have moved
+            std::uint64_t count = adapter->header()->bucketCount;
+            for (; slot < count && out.size() < chunkSize; ++slot) {
+                const Bucket& bucket = buckets[slot];
+                if (bucket.state != LIVE) {
+                    continue;
+                }
+                const char* record = adapter->base + bucket.offset;
+                std::string key(record, bucket.keyLen);
+                if (matchesPrefix(key)) {
+                    out.emplace_back(std::move(key), std::string(record + bucket.keyLen, bucket.valueLen));
+                }
+            }
+            return slot < count;
+        }
+
+    public:
+        ScanCursor(const MemoryMappedStorageAdapter* adapter, const std::string& prefix, std::size_t chunkSize)
+            : ChunkedStorageCursor(prefix, chunkSize), adapter(adapter) {}
+    };
+
+public:
+    explicit MemoryMappedStorageAdapter(const std::string& filePath = "archinote.mmap") : filePath(filePath) {
+        fd = ::open(filePath.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("MemoryMappedStorageAdapter: cannot open " + filePath);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            throw std::runtime_error("MemoryMappedStorageAdapter: cannot stat " + filePath);
+        }
+        try {
+            if (st.st_size == 0) {
+                initialize();
+            } else {
+                if (static_cast<std::uint64_t>(st.st_size) < sizeof(Header)) {
+                    throw std::runtime_error("MemoryMappedStorageAdapter: truncated file " + filePath);
+                }
+                mapFile(static_cast<std::uint64_t>(st.st_size));
+                if (header()->magic != FILE_MAGIC || header()->version != FILE_VERSION ||
+                    header()->dataEnd > mappedSize) {
+                    throw std::runtime_error("MemoryMappedStorageAdapter: not an ArchiNote mmap store: " + filePath);
+                }
+                liveBytes = countLiveBytes();
+            }
+        } catch (...) {
+            if (base) ::munmap(base, mappedSize);
+            ::close(fd);
+            throw;
+        }
+    }
+
+    ~MemoryMappedStorageAdapter() override {
+        if (base) {
+            ::msync(base, mappedSize, MS_SYNC);
+            ::munmap(base, mappedSize);
+        }
+        ::close(fd);
+    }
+
+    // No copy (owns the mapping)
+    MemoryMappedStorageAdapter(const MemoryMappedStorageAdapter&) = delete;
+    MemoryMappedStorageAdapter& operator=(const MemoryMappedStorageAdapter&) = delete;
+
+    void save(const std::string& key, const std::string& data) override {
+        requireEncodable(key, data);
+        std::lock_guard<std::mutex> lock(mutex);
+        std::uint64_t hash = hashKey(key.data(), key.size());
+        bool found = false;
+        Bucket* bucket = probe(key, hash, found);
+        if (found && bucket->capacity >= data.size()) {
+            // Overwrite in place
+            std::memcpy(base + bucket->offset + bucket->keyLen, data.data(), data.size());
+            bucket->valueLen = static_cast<std::uint32_t>(data.size());
+            return;
+        }
+        if (!found && (header()->usedBuckets + 1) * 10 > header()->bucketCount * 7) {
+            // Keep load factor <= 0.7; tombstone-heavy tables are rehashed at the same size
+            bool mostlyTombstones = header()->liveCount * 2 < header()->usedBuckets;
+            rehash(mostlyTombstones ? header()->bucketCount : header()->bucketCount * 2);
+        }
+        reserve(key.size() + data.size());
+        bucket = probe(key, hash, found);  // Mapping or table may have moved
+        std::uint64_t offset = header()->dataEnd;
+        std::memcpy(base + offset, key.data(), key.size());
+        std::memcpy(base + offset + key.size(), data.data(), data.size());
+        header()->dataEnd = offset + key.size() + data.size();
+        if (!found) {
+            if (bucket->state == EMPTY) {
+                header()->usedBuckets += 1;
+            }
+            header()->liveCount += 1;
+        } else {
+            liveBytes -= recordBytes(*bucket);  // Relocated: the old record is dead
+        }
+        liveBytes += key.size() + data.size();
+        bucket->hash = hash;
+        bucket->offset = offset;
+        bucket->keyLen = static_cast<std::uint32_t>(key.size());
+        bucket->valueLen = static_cast<std::uint32_t>(data.size());
+        bucket->capacity = static_cast<std::uint32_t>(data.size());
+        bucket->state = LIVE;
+        compactIfNeeded();
+    }
+
+    std::string load(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::string_view view = loadView(key);
+        return std::string(view.data(), view.size());
+    }
+
+    // Zero-copy load: the view points into the mapping and is valid until the next save()/remove()/compact()
+    std::string_view loadView(std::string_view key) const {
+        bool found = false;
+        const Bucket* bucket = probe(key, hashKey(key.data(), key.size()), found);
+        if (!found) {
+            return std::string_view();
+        }
+        return std::string_view(base + bucket->offset + bucket->keyLen, bucket->valueLen);
+    }
+
+    void remove(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        bool found = false;
+        Bucket* bucket = probe(key, hashKey(key.data(), key.size()), found);
+        if (found) {
+            bucket->state = DELETED;  // Record bytes are left in place until the next compaction
+            header()->liveCount -= 1;
+            liveBytes -= recordBytes(*bucket);
+            compactIfNeeded();
+        }
+    }
+
+    RawPtrWrapper<IStorageCursor> scan(const std::string& prefix = "") override {
+        RawPtrWrapper<IStorageCursor> cursor(new ScanCursor(this, prefix, 256));
+        return RawPtrWrapper<IStorageCursor>(new LockedStorageCursor(std::move(cursor), mutex));
+    }
+
+    bool supportsScan() const override { return true; }
+
+    void flush() override {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (::msync(base, mappedSize, MS_SYNC) != 0) {
+            throw std::runtime_error("MemoryMappedStorageAdapter: msync failed");
+        }
+    }
+
+    // Rewrite the file with only the live records, whatever the amount of dead bytes
+    void compact() {
+        std::lock_guard<std::mutex> lock(mutex);
+        compactLocked();
+    }
+
+    std::size_t size() const { return static_cast<std::size_t>(header()->liveCount); }
+
+    // Bytes held by removed/overwritten records and superseded tables
+    std::size_t reclaimableBytes() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return static_cast<std::size_t>(deadBytes());
+    }
+
+    std::size_t fileSize() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return static_cast<std::size_t>(mappedSize);
+    }
+};
+
+
+
+
+#endif // __MEMORYMAPPEDSTORAGEADAPTER_HPP__
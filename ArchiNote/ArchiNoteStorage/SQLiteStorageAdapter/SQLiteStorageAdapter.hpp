@@ -0,0 +1,382 @@
+#ifndef __SQLITESTORAGEADAPTER_HPP__
+#define __SQLITESTORAGEADAPTER_HPP__
+
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <functional>
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include "../IStorageAdapter.hpp"
+
+#ifdef HAS_SQLITE3
+#include <sqlite3.h>
+#endif
+
+
+
+
+#ifdef HAS_SQLITE3
+
+// SQLite storage adapter
+// Table attributes(key TEXT PRIMARY KEY, data BLOB) in WAL mode with cached prepared statements.
+// Consecutive save()/remove() calls share one write transaction, committed once it holds
+// maxBatchOps operations or has been open for maxBatchDelay (a background committer enforces
+// the deadline when writes stop). load() runs on the same connection and sees uncommitted writes.
+class SQLiteStorageAdapter : public IStorageAdapter {
+private:
+    sqlite3* db = nullptr;
+    sqlite3_stmt* upsertStmt = nullptr;
+    sqlite3_stmt* selectStmt = nullptr;
+    sqlite3_stmt* deleteStmt = nullptr;
+    sqlite3_stmt* beginStmt = nullptr;
+    sqlite3_stmt* commitStmt = nullptr;
+    sqlite3_stmt* savepointStmt = nullptr;  // Batches run inside a savepoint of the open transaction ...
+    sqlite3_stmt* releaseStmt = nullptr;
+    sqlite3_stmt* rollbackToStmt = nullptr;  // ... so a failed batch is undone without the earlier writes
+    sqlite3_stmt* scanFromStmt = nullptr;  // Keyset pagination: first page starts at the prefix ...
+    sqlite3_stmt* scanAfterStmt = nullptr;  // ... later pages start after the last key returned
+
+    std::size_t maxBatchOps;
+    std::chrono::milliseconds maxBatchDelay;
+
+    std::mutex mutex;  // Guards the connection and the batch state below
+    bool inTransaction = false;
+    std::size_t pendingOps = 0;
+    std::chrono::steady_clock::time_point batchDeadline;
+
+    std::thread committerThread;
+    std::condition_variable committerWakeup;
+    bool stopping = false;
+
+    void check(int rc, const char* what) const {
+        if (rc != SQLITE_OK && rc != SQLITE_DONE && rc != SQLITE_ROW) {
+            throw std::runtime_error(std::string("SQLite: ") + what + ": " + sqlite3_errmsg(db));
+        }
+    }
+
+    sqlite3_stmt* prepare(const char* sql) {
+        sqlite3_stmt* stmt = nullptr;
+        check(sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr), sql);
+        return stmt;
+    }
+
+    // Run a cached statement to completion and reset it for reuse
+    void run(sqlite3_stmt* stmt, const char* what) {
+        int rc = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+        check(rc, what);
+    }
+
+    // Caller holds the mutex
+    void beginIfNeeded() {
+        if (inTransaction) {
+            return;
+        }
+        run(beginStmt, "begin transaction");
+        inTransaction = true;
+        pendingOps = 0;
+        batchDeadline = std::chrono::steady_clock::now() + maxBatchDelay;
+        committerWakeup.notify_one();
+    }
+
+    // Caller holds the mutex
+    void commit() {
+        if (!inTransaction) {
+            return;
+        }
+        run(commitStmt, "commit transaction");
+        inTransaction = false;
+        pendingOps = 0;
+    }
+
+    // Caller holds the mutex. Runs apply() as one all-or-nothing unit inside the open transaction
+    // (or a new one) and commits. If a statement fails, the savepoint is rolled back, so nothing of
+    // the batch reaches the next commit, and the error is rethrown.
+    template <typename Apply>
+    void runBatch(Apply apply) {
+        beginIfNeeded();
+        run(savepointStmt, "savepoint");
+        try {
+            apply();
+        } catch (...) {
+            try {
+                run(rollbackToStmt, "rollback batch");
+                run(releaseStmt, "release savepoint");
+            } catch (const std::exception& e) {
+                std::cerr << "SQLiteStorageAdapter: batch rollback failed: " << e.what() << std::endl;
+            }
+            throw;
+        }
+        run(releaseStmt, "release savepoint");
+        commit();
+    }
+
+    // Caller holds the mutex
+    void operationApplied() {
+        pendingOps += 1;
+        if (pendingOps >= maxBatchOps || std::chrono::steady_clock::now() >= batchDeadline) {
+            commit();
+        }
+    }
+
+    void committerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            if (!inTransaction) {
+                committerWakeup.wait(lock);
+                continue;
+            }
+            if (committerWakeup.wait_until(lock, batchDeadline) == std::cv_status::timeout && inTransaction &&
+                std::chrono::steady_clock::now() >= batchDeadline) {
+                try {
+                    commit();
+                } catch (const std::exception& e) {
+                    std::cerr << "SQLiteStorageAdapter: deferred commit failed: " << e.what() << std::endl;
+                    batchDeadline = std::chrono::steady_clock::now() + maxBatchDelay;
+                }
+            }
+        }
+    }
+
+    // Caller holds the mutex
+    std::string selectValue(const std::string& key) {
+        sqlite3_bind_text(selectStmt, 1, key.data(), static_cast<int>(key.size()), SQLITE_STATIC);
+        int rc = sqlite3_step(selectStmt);
+        std::string data;
+        if (rc == SQLITE_ROW) {
+            const void* blob = sqlite3_column_blob(selectStmt, 0);
+            int length = sqlite3_column_bytes(selectStmt, 0);
+            if (blob && length > 0) {
+                data.assign(static_cast<const char*>(blob), static_cast<std::size_t>(length));
+            }
+        }
+        sqlite3_reset(selectStmt);
+        sqlite3_clear_bindings(selectStmt);
+        check(rc, "load");
+        return data;
+    }
+
+    // Pages through the primary key; each page is one indexed range query
+    class ScanCursor : public ChunkedStorageCursor {
+    private:
+        SQLiteStorageAdapter* adapter;
+        std::string resumeKey;
+        bool started = false;
+
+    protected:
+        bool fetchChunk(std::vector<std::pair<std::string, std::string>>& out) override {
+            std::lock_guard<std::mutex> lock(adapter->mutex);
+            sqlite3_stmt* stmt = started ? adapter->scanAfterStmt : adapter->scanFromStmt;
+            const std::string& start = started ? resumeKey : prefix;
+            started = true;
+            sqlite3_bind_text(stmt, 1, start.data(), static_cast<int>(start.size()), SQLITE_TRANSIENT);
+            sqlite3_bind_int64(stmt, 2, static_cast<sqlite3_int64>(chunkSize));
+            std::size_t rows = 0;
+            bool inRange = true;
+            int rc;
+            while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+                ++rows;
+                std::string key(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)),
+                                static_cast<std::size_t>(sqlite3_column_bytes(stmt, 0)));
+                if (!matchesPrefix(key)) {
+                    inRange = false;  // Ordered by key: past the prefix range
+                    break;
+                }
+                const void* blob = sqlite3_column_blob(stmt, 1);
+                int length = sqlite3_column_bytes(stmt, 1);
+                std::string value;
+                if (blob && length > 0) {
+                    value.assign(static_cast<const char*>(blob), static_cast<std::size_t>(length));
+                }
+                resumeKey = key;
+                out.emplace_back(std::move(key), std::move(value));
+            }
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+            adapter->check(rc, "scan");
+            return inRange && rows == chunkSize;
+        }
+
+    public:
+        ScanCursor(SQLiteStorageAdapter* adapter, const std::string& prefix, std::size_t chunkSize)
+            : ChunkedStorageCursor(prefix, chunkSize), adapter(adapter) {}
+    };
+
+    void closeConnection() {
+        sqlite3_finalize(upsertStmt);
+        sqlite3_finalize(selectStmt);
+        sqlite3_finalize(deleteStmt);
+        sqlite3_finalize(beginStmt);
+        sqlite3_finalize(commitStmt);
+        sqlite3_finalize(savepointStmt);
+        sqlite3_finalize(releaseStmt);
+        sqlite3_finalize(rollbackToStmt);
+        sqlite3_finalize(scanFromStmt);
+        sqlite3_finalize(scanAfterStmt);
+        sqlite3_close(db);
+        db = nullptr;
+    }
+
+public:
+    explicit SQLiteStorageAdapter(const std::string& filePath = "archinote.db", std::size_t maxBatchOps = 512,
+                                  std::chrono::milliseconds maxBatchDelay = std::chrono::milliseconds(200))
+        : maxBatchOps(std::max<std::size_t>(1, maxBatchOps)), maxBatchDelay(maxBatchDelay) {
+        if (sqlite3_open_v2(filePath.c_str(), &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE, nullptr) != SQLITE_OK) {
+            std::string message = db ? sqlite3_errmsg(db) : "out of memory";
+            sqlite3_close(db);
+            throw std::runtime_error("SQLite: cannot open " + filePath + ": " + message);
+        }
+        try {
+            // WAL: commits append to the log instead of rewriting pages; NORMAL only fsyncs at checkpoints
+            check(sqlite3_exec(db, "PRAGMA journal_mode=WAL;", nullptr, nullptr, nullptr), "journal_mode");
+            check(sqlite3_exec(db, "PRAGMA synchronous=NORMAL;", nullptr, nullptr, nullptr), "synchronous");
+            check(sqlite3_exec(db,
+                               "CREATE TABLE IF NOT EXISTS attributes ("
+                               "key TEXT PRIMARY KEY NOT NULL, data BLOB NOT NULL) WITHOUT ROWID;",
+                               nullptr, nullptr, nullptr),
+                  "create table");
+            upsertStmt = prepare("INSERT OR REPLACE INTO attributes (key, data) VALUES (?1, ?2);");
+            selectStmt = prepare("SELECT data FROM attributes WHERE key = ?1;");
+            deleteStmt = prepare("DELETE FROM attributes WHERE key = ?1;");
+            beginStmt = prepare("BEGIN IMMEDIATE;");
+            commitStmt = prepare("COMMIT;");
+            savepointStmt = prepare("SAVEPOINT batch;");
+            releaseStmt = prepare("RELEASE batch;");
+            rollbackToStmt = prepare("ROLLBACK TO batch;");
+            scanFromStmt = prepare("SELECT key, data FROM attributes WHERE key >= ?1 ORDER BY key LIMIT ?2;");
+            scanAfterStmt = prepare("SELECT key, data FROM attributes WHERE key > ?1 ORDER BY key LIMIT ?2;");
+        } catch (...) {
+            closeConnection();
+            throw;
+        }
+        committerThread = std::thread(&SQLiteStorageAdapter::committerLoop, this);
+    }
+
+    ~SQLiteStorageAdapter() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            try {
+                commit();
+            } catch (const std::exception& e) {
+                std::cerr << "SQLiteStorageAdapter: commit on close failed: " << e.what() << std::endl;
+            }
+        }
+        committerWakeup.notify_one();
+        committerThread.join();
+        closeConnection();
+    }
+
+    // No copy (owns the connection)
+    SQLiteStorageAdapter(const SQLiteStorageAdapter&) = delete;
+    SQLiteStorageAdapter& operator=(const SQLiteStorageAdapter&) = delete;
+
+    void save(const std::string& key, const std::string& data) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        beginIfNeeded();
+        sqlite3_bind_text(upsertStmt, 1, key.data(), static_cast<int>(key.size()), SQLITE_STATIC);
+        sqlite3_bind_blob(upsertStmt, 2, data.data(), static_cast<int>(data.size()), SQLITE_STATIC);
+        run(upsertStmt, "save");
+        operationApplied();
+    }
+
+    std::string load(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        return selectValue(key);
+    }
+
+    void remove(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        beginIfNeeded();
+        sqlite3_bind_text(deleteStmt, 1, key.data(), static_cast<int>(key.size()), SQLITE_STATIC);
+        run(deleteStmt, "remove");
+        operationApplied();
+    }
+
+    // Batches are all-or-nothing and commit once at the end (see runBatch)
+    void saveBatch(const std::vector<std::string>& keys, const std::vector<std::string>& values) override {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("saveBatch: keys and values differ in length");
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        runBatch([&] {
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                sqlite3_bind_text(upsertStmt, 1, keys[i].data(), static_cast<int>(keys[i].size()), SQLITE_STATIC);
+                sqlite3_bind_blob(upsertStmt, 2, values[i].data(), static_cast<int>(values[i].size()), SQLITE_STATIC);
+                run(upsertStmt, "save");
+            }
+        });
+    }
+
+    std::vector<std::string> loadMany(const std::vector<std::string>& keys) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::string> values;
+        values.reserve(keys.size());
+        for (const auto& key : keys) {
+            values.push_back(selectValue(key));
+        }
+        return values;
+    }
+
+    void removeMany(const std::vector<std::string>& keys) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        runBatch([&] {
+            for (const auto& key : keys) {
+                sqlite3_bind_text(deleteStmt, 1, key.data(), static_cast<int>(key.size()), SQLITE_STATIC);
+                run(deleteStmt, "remove");
+            }
+        });
+    }
+
+    RawPtrWrapper<IStorageCursor> scan(const std::string& prefix = "") override {
+        return RawPtrWrapper<IStorageCursor>(new ScanCursor(this, prefix, 256));
+    }
+
+    bool supportsScan() const override { return true; }
+
+    // Commit the open batch now
+    void flush() override {
+        std::lock_guard<std::mutex> lock(mutex);
+        commit();
+    }
+};
+
+
+
+
+#else
+
+// SQLite storage adapter (placeholder, built without HAS_SQLITE3): refuses to be constructed, so a
+// build without SQLite fails loudly instead of silently dropping every write
+class SQLiteStorageAdapter : public IStorageAdapter {
+public:
+    explicit SQLiteStorageAdapter(const std::string& filePath = "archinote.db", std::size_t maxBatchOps = 512,
+                                  std::chrono::milliseconds maxBatchDelay = std::chrono::milliseconds(200)) {
+        (void)maxBatchOps;
+        (void)maxBatchDelay;
+        throw std::runtime_error("SQLiteStorageAdapter: built without SQLite support (HAS_SQLITE3), cannot open " +
+                                 filePath);
+    }
+    void save(const std::string&, const std::string&) override {}
+    std::string load(const std::string&) override { return ""; }
+    void remove(const std::string&) override {}
+};
+
+#endif // HAS_SQLITE3
+
+
+
+
+#endif // __SQLITESTORAGEADAPTER_HPP__
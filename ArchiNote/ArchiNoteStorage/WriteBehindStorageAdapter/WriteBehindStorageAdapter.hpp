@@ -0,0 +1,272 @@
+#ifndef __WRITEBEHINDSTORAGEADAPTER_HPP__
+#define __WRITEBEHINDSTORAGEADAPTER_HPP__
+
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <functional>
+#include <stdexcept>
+#include <exception>
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include "../IStorageAdapter.hpp"
+
+
+
+
+// Write-behind storage decorator
+// save()/remove() only queue the operation and return; a background writer applies the queue to
+// the wrapped adapter with one saveBatch()/removeMany() per round. Queued operations on the same
+// key coalesce (last one wins), so a burst of edits to one attribute costs one backend write.
+// load() sees queued writes. flush() is a barrier: it returns once everything queued before it is
+// in the wrapped adapter and that adapter has been flushed.
+// Takes ownership of the wrapped adapter.
+class WriteBehindStorageAdapter : public IStorageAdapter {
+private:
+    struct PendingOp {
+        bool removal = false;
+        std::string data;
+    };
+
+    IStorageAdapter* inner;
+    std::chrono::milliseconds maxDelay;  // How long the writer lets a round accumulate
+    std::size_t maxPendingOps;  // save()/remove() block while this many distinct keys are queued
+
+    std::mutex mutex;  // Guards the queue state below
+    std::map<std::string, PendingOp> pending;  // Queued, not yet picked up by the writer
+    std::map<std::string, PendingOp> inFlight;  // Being applied by the writer right now
+    std::condition_variable writerWakeup;
+    std::condition_variable drained;  // Signalled after every round
+    std::size_t flushRequests = 0;  // Writers skip the accumulation delay while > 0
+    std::size_t coalesced = 0;
+    std::exception_ptr writeError;  // First failed round, rethrown by the next flush()
+    bool stopping = false;
+
+    std::mutex innerMutex;  // Serialises every call into the wrapped adapter
+    std::thread writerThread;
+
+    // Caller holds the mutex
+    void enqueue(std::unique_lock<std::mutex>& lock, const std::string& key, bool removal, const std::string& data) {
+        drained.wait(lock, [this, &key] { return pending.size() < maxPendingOps || pending.count(key) || stopping; });
+        auto it = pending.find(key);
+        if (it != pending.end()) {
+            coalesced += 1;
+            it->second.removal = removal;
+            it->second.data = data;
+        } else {
+            pending.emplace(key, PendingOp{removal, data});
+        }
+    }
+
+    // Caller holds the mutex. Returns true and fills `value` if the key has a queued operation
+    bool lookupQueued(const std::string& key, std::string& value) const {
+        for (const auto* queue : {&pending, &inFlight}) {
+            auto it = queue->find(key);
+            if (it != queue->end()) {
+                value = it->second.removal ? std::string() : it->second.data;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Runs without the mutex: inFlight is only read here and by load() until the round ends
+    void applyRound() {
+        std::vector<std::string> saveKeys;
+        std::vector<std::string> saveValues;
+        std::vector<std::string> removeKeys;
+        for (const auto& pair : inFlight) {
+            if (pair.second.removal) {
+                removeKeys.push_back(pair.first);
+            } else {
+                saveKeys.push_back(pair.first);
+                saveValues.push_back(pair.second.data);
+            }
+        }
+        std::lock_guard<std::mutex> lock(innerMutex);
+        if (!removeKeys.empty()) {
+            inner->removeMany(removeKeys);
+        }
+        if (!saveKeys.empty()) {
+            inner->saveBatch(saveKeys, saveValues);
+        }
+    }
+
+    void writerLoop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            writerWakeup.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) {
+                return;  // Stopping and drained
+            }
+            if (!stopping && flushRequests == 0) {
+                // Let the round accumulate (and coalesce) unless someone is waiting on it
+                writerWakeup.wait_for(lock, maxDelay, [this] {
+                    return stopping || flushRequests > 0 || pending.size() >= maxPendingOps;
+                });
+            }
+            inFlight.swap(pending);
+            drained.notify_all();  // Unblocks enqueue() waiting on maxPendingOps
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                applyRound();
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (error && !writeError) {
+                writeError = error;
+            }
+            inFlight.clear();
+            drained.notify_all();
+        }
+    }
+
+public:
+    explicit WriteBehindStorageAdapter(IStorageAdapter* inner,
+                                       std::chrono::milliseconds maxDelay = std::chrono::milliseconds(50),
+                                       std::size_t maxPendingOps = 4096)
+        : inner(inner), maxDelay(maxDelay), maxPendingOps(std::max<std::size_t>(1, maxPendingOps)) {
+        if (!inner) {
+            throw std::invalid_argument("WriteBehindStorageAdapter: inner adapter is null");
+        }
+        writerThread = std::thread(&WriteBehindStorageAdapter::writerLoop, this);
+    }
+
+    ~WriteBehindStorageAdapter() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        writerWakeup.notify_one();
+        drained.notify_all();
+        writerThread.join();  // The writer drains the queue before exiting
+        try {
+            if (writeError) {
+                std::rethrow_exception(writeError);
+            }
+            inner->flush();
+        } catch (const std::exception& e) {
+            std::cerr << "WriteBehindStorageAdapter: write on close failed: " << e.what() << std::endl;
+        }
+        delete inner;
+    }
+
+    // No copy (owns the wrapped adapter and a background thread)
+    WriteBehindStorageAdapter(const WriteBehindStorageAdapter&) = delete;
+    WriteBehindStorageAdapter& operator=(const WriteBehindStorageAdapter&) = delete;
+
+    void save(const std::string& key, const std::string& data) override {
+        std::unique_lock<std::mutex> lock(mutex);
+        enqueue(lock, key, false, data);
+        writerWakeup.notify_one();
+    }
+
+    std::string load(const std::string& key) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::string value;
+            if (lookupQueued(key, value)) {
+                return value;
+            }
+        }
+        std::lock_guard<std::mutex> lock(innerMutex);
+        return inner->load(key);
+    }
+
+    void remove(const std::string& key) override {
+        std::unique_lock<std::mutex> lock(mutex);
+        enqueue(lock, key, true, std::string());
+        writerWakeup.notify_one();
+    }
+
+    void saveBatch(const std::vector<std::string>& keys, const std::vector<std::string>& values) override {
+        if (keys.size() != values.size()) {
+            throw std::invalid_argument("saveBatch: keys and values differ in length");
+        }
+        std::unique_lock<std::mutex> lock(mutex);
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            enqueue(lock, keys[i], false, values[i]);
+        }
+        writerWakeup.notify_one();
+    }
+
+    std::vector<std::string> loadMany(const std::vector<std::string>& keys) override {
+        std::vector<std::string> values(keys.size());
+        std::vector<std::string> missKeys;
+        std::vector<std::size_t> missSlots;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+                if (!lookupQueued(keys[i], values[i])) {
+                    missKeys.push_back(keys[i]);
+                    missSlots.push_back(i);
+                }
+            }
+        }
+        if (!missKeys.empty()) {
+            std::lock_guard<std::mutex> lock(innerMutex);
+            std::vector<std::string> loaded = inner->loadMany(missKeys);
+            for (std::size_t i = 0; i < loaded.size(); ++i) {
+                values[missSlots[i]] = std::move(loaded[i]);
+            }
+        }
+        return values;
+    }
+
+    void removeMany(const std::vector<std::string>& keys) override {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (const auto& key : keys) {
+            enqueue(lock, key, true, std::string());
+        }
+        writerWakeup.notify_one();
+    }
+
+    // Drains the queue first, so the scan starts from everything written so far
+    RawPtrWrapper<IStorageCursor> scan(const std::string& prefix = "") override {
+        flush();
+        std::lock_guard<std::mutex> lock(innerMutex);
+        return RawPtrWrapper<IStorageCursor>(new LockedStorageCursor(inner->scan(prefix), innerMutex));
+    }
+
+    bool supportsScan() const override { return inner->supportsScan(); }
+
+    // Barrier: wait for the queue to drain, then flush the wrapped adapter.
+    // Rethrows the first background write failure since the last flush().
+    void flush() override {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            flushRequests += 1;
+            writerWakeup.notify_one();
+            drained.wait(lock, [this] { return pending.empty() && inFlight.empty(); });
+            flushRequests -= 1;
+            if (writeError) {
+                std::exception_ptr error = writeError;
+                writeError = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+        std::lock_guard<std::mutex> lock(innerMutex);
+        inner->flush();
+    }
+
+    // Number of queued operations absorbed by a later operation on the same key
+    std::size_t coalescedCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return coalesced;
+    }
+};
+
+
+
+
+#endif // __WRITEBEHINDSTORAGEADAPTER_HPP__
@@ -0,0 +1,425 @@
+#ifndef __CONTENTBLOBSTORE_HPP__
+#define __CONTENTBLOBSTORE_HPP__
+
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <mutex>
+#include <atomic>
+#include <stdexcept>
+
+#include "../Structs/JSONFields.hpp"
+#include "../ArchiNoteMemory/Arena.hpp"
+#include "../ArchiNoteStorage/IStorageAdapter.hpp"
+
+
+
+
+// Reference to a blob: the hash of its bytes
+typedef std::uint64_t ContentRef;
+
+// Content-addressed, reference-counted blob store for version history
+// A blob's ref is a hash of its bytes, so storing the same bytes twice only bumps a counter.
+// Versions are stored one level deeper: every field of a content's flat JSON object is its own blob
+// and the version itself is a small manifest blob listing the field refs. Identical versions share
+// one manifest; an update that touches one field re-uses the blobs of all the others.
+// Refs are stable across runs, which makes persist() idempotent: a blob is written under the same
+// key every time, and only blobs not yet written are sent. load() stages the stored blobs with no
+// references; restoring a record adopts its versions with retainVersion(), and prune() then drops
+// (and deletes from storage) whatever no restored record referenced.
+// Blob bytes are packed into an Arena rather than allocated one by one. Released bytes stay in the
+// arena until they outweigh the live ones, then the live blobs are copied into a fresh arena.
+// An owner that is about to drop the whole store calls beginTeardown(): later releases are no-ops,
+// so destroying n attributes does not cost n manifest lookups first.
+class ContentBlobStore {
+private:
+    static constexpr std::size_t MIN_COMPACT_BYTES = 1024 * 1024;
+
+    struct Blob {
+        std::string_view data;  // In `arena`
+        std::size_t refs = 0;
+        bool persisted = false;
+    };
+
+    mutable std::mutex mutex;  // Guards everything below
+    std::unordered_map<ContentRef, Blob> blobs;
+    Arena arena;
+    std::size_t storedBytes = 0;  // Live blob bytes
+    std::size_t deadBytes = 0;  // Released, still in the arena
+    std::atomic<bool> tearingDown{false};
+
+    static std::uint64_t mix(std::uint64_t value) {
+        value ^= value >> 30;
+        value *= 0xbf58476d1ce4e5b9ULL;
+        value ^= value >> 27;
+        value *= 0x94d049bb133111ebULL;
+        value ^= value >> 31;
+        return value;
+    }
+
+    // Caller holds the mutex
+    void retainLocked(ContentRef ref, std::string_view data) {
+        auto it = blobs.find(ref);
+        if (it == blobs.end()) {
+            Blob blob;
+            blob.data = arena.copy(data);
+            blob.refs = 1;
+            storedBytes += data.size();
+            blobs.emplace(ref, std::move(blob));
+            return;
+        }
+        if (it->second.data != data) {
+            throw std::runtime_error("ContentBlobStore: hash collision on " + toHex(ref));
+        }
+        it->second.refs += 1;
+    }
+
+    // Caller holds the mutex. Returns true when the blob was dropped
+    bool releaseLocked(ContentRef ref) {
+        auto it = blobs.find(ref);
+        if (it == blobs.end()) {
+            return false;
+        }
+        if (--it->second.refs > 0) {
+            return false;
+        }
+        storedBytes -= it->second.data.size();
+        deadBytes += it->second.data.size();
+        blobs.erase(it);
+        return true;
+    }
+
+    // Caller holds the mutex. Moves the live blobs into a fresh arena once most of it is dead
+    void compactLocked() {
+        if (deadBytes < MIN_COMPACT_BYTES || deadBytes < storedBytes) {
+            return;
+        }
+        Arena fresh;
+        for (auto& pair : blobs) {
+            pair.second.data = fresh.copy(pair.second.data);
+        }
+        arena = std::move(fresh);
+        deadBytes = 0;
+    }
+
+    // Caller holds the mutex
+    std::string_view dataLocked(ContentRef ref) const {
+        auto it = blobs.find(ref);
+        if (it == blobs.end()) {
+            throw std::invalid_argument("ContentBlobStore: unknown blob " + toHex(ref));
+        }
+        return it->second.data;
+    }
+
+    // Manifest: one "<field>\t<ref>\n" line per field, in document order. Field names view `manifest`
+    static std::vector<std::pair<std::string_view, ContentRef>> parseManifest(std::string_view manifest) {
+        std::vector<std::pair<std::string_view, ContentRef>> fields;
+        std::size_t pos = 0;
+        while (pos < manifest.size()) {
+            std::size_t tab = manifest.find('\t', pos);
+            std::size_t end = manifest.find('\n', pos);
+            if (tab == std::string_view::npos || end == std::string_view::npos || tab > end) {
+                throw std::invalid_argument("ContentBlobStore: malformed version manifest");
+            }
+            fields.emplace_back(manifest.substr(pos, tab - pos), fromHex(manifest.substr(tab + 1, end - tab - 1)));
+            pos = end + 1;
+        }
+        return fields;
+    }
+
+public:
+    // Default prefix of persisted blob keys. They share the adapter with the attribute records,
+    // so record scans skip them with isBlobKey()
+    static constexpr const char* KEY_PREFIX = "__blob__/";
+
+    static bool isBlobKey(const std::string& key) {
+        return key.compare(0, std::strlen(KEY_PREFIX), KEY_PREFIX) == 0;
+    }
+
+    ContentBlobStore() = default;
+
+    // No copy (refs held by attributes point into this instance)
+    ContentBlobStore(const ContentBlobStore&) = delete;
+    ContentBlobStore& operator=(const ContentBlobStore&) = delete;
+
+    // Process-wide store shared by all Versioned* attributes
+    static ContentBlobStore& shared() {
+        static ContentBlobStore store;
+        return store;
+    }
+
+    // 64-bit hash, 8 bytes per step. Part of the persisted key format: must stay stable across builds
+    static ContentRef hash(const std::string& data) {
+        std::uint64_t h = 0x9e3779b97f4a7c15ULL ^ (data.size() * 0xff51afd7ed558ccdULL);
+        std::size_t i = 0;
+        for (; i + 8 <= data.size(); i += 8) {
+            std::uint64_t word;
+            std::memcpy(&word, data.data() + i, 8);
+            h = mix(h ^ word) * 0x9fb21c651e98df25ULL;
+        }
+        std::uint64_t tail = 0;
+        std::memcpy(&tail, data.data() + i, data.size() - i);
+        return mix(h ^ tail ^ (data.size() - i));
+    }
+
+    static std::string toHex(ContentRef ref) {
+        char text[17];
+        std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(ref));
+        return text;
+    }
+
+    static ContentRef fromHex(std::string_view text) {
+        ContentRef value = 0;
+        bool valid = text.size() == 16;
+        for (std::size_t i = 0; valid && i < text.size(); ++i) {
+            char c = text[i];
+            int digit = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+                        (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+            valid = digit >= 0;
+            value = (value << 4) | static_cast<ContentRef>(digit & 0xf);
+        }
+        if (!valid) {
+            throw std::invalid_argument("ContentBlobStore: malformed blob ref: " + std::string(text));
+        }
+        return value;
+    }
+
+    // Raw blobs
+    ContentRef put(const std::string& data) {
+        ContentRef ref = hash(data);
+        std::lock_guard<std::mutex> lock(mutex);
+        retainLocked(ref, data);
+        return ref;
+    }
+
+    std::string get(ContentRef ref) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::string(dataLocked(ref));
+    }
+
+    void release(ContentRef ref) {
+        if (tearingDown.load(std::memory_order_relaxed)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        releaseLocked(ref);
+        compactLocked();
+    }
+
+    // Versions of a flat JSON object (a content's toJSON()). The manifest holds the only reference
+    // to each field blob, so repeated versions cost one counter bump.
+    ContentRef putVersion(const std::string& json) {
+        std::vector<std::pair<std::string, std::string>> fields = JSONFields::readRawObject(json);
+        std::string manifest;
+        std::vector<ContentRef> fieldRefs;
+        fieldRefs.reserve(fields.size());
+        for (const auto& field : fields) {
+            fieldRefs.push_back(hash(field.second));
+            manifest += field.first + "\t" + toHex(fieldRefs.back()) + "\n";
+        }
+        ContentRef ref = hash(manifest);
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = blobs.find(ref);
+        if (it == blobs.end() || it->second.refs == 0) {  // New, or only staged by load()
+            for (std::size_t i = 0; i < fields.size(); ++i) {
+                retainLocked(fieldRefs[i], fields[i].second);
+            }
+        }
+        retainLocked(ref, manifest);
+        return ref;
+    }
+
+    // Take a reference on a version already in the store (e.g. staged by load()), as putVersion()
+    // would. False if the manifest or one of its field blobs is missing
+    bool retainVersion(ContentRef ref) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = blobs.find(ref);
+        if (it == blobs.end()) {
+            return false;
+        }
+        if (it->second.refs == 0) {
+            std::vector<std::pair<std::string_view, ContentRef>> fields = parseManifest(it->second.data);
+            for (const auto& field : fields) {
+                if (blobs.find(field.second) == blobs.end()) {
+                    return false;
+                }
+            }
+            for (const auto& field : fields) {
+                blobs[field.second].refs += 1;
+            }
+        }
+        it->second.refs += 1;
+        return true;
+    }
+
+    // Re-assemble the JSON object stored by putVersion()
+    std::string getVersion(ContentRef ref) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::string json = "{ ";
+        bool first = true;
+        for (const auto& field : parseManifest(dataLocked(ref))) {
+            if (!first) json += ", ";
+            json += "\"";
+            json += JSONFields::escape(std::string(field.first));
+            json += "\": ";
+            json += dataLocked(field.second);
+            first = false;
+        }
+        json += " }";
+        return json;
+    }
+
+    void releaseVersion(ContentRef ref) {
+        if (tearingDown.load(std::memory_order_relaxed)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = blobs.find(ref);
+        if (it == blobs.end()) {
+            return;
+        }
+        if (it->second.refs > 1) {
+            it->second.refs -= 1;
+            return;
+        }
+        // Last reference: the manifest bytes stay in the arena until the next compaction
+        std::vector<std::pair<std::string_view, ContentRef>> fields = parseManifest(it->second.data);
+        releaseLocked(ref);
+        for (const auto& field : fields) {
+            releaseLocked(field.second);
+        }
+        compactLocked();
+    }
+
+    // The owner is about to destroy the store with everything in it: skip all further releases
+    void beginTeardown() {
+        tearingDown.store(true);
+    }
+
+    // Persistence: write every blob not yet written, under "<prefix><hex ref>", in one batch
+    void persist(IStorageAdapter& adapter, const std::string& prefix = KEY_PREFIX) {
+        std::vector<std::string> keys;
+        std::vector<std::string> values;
+        std::vector<ContentRef> refs;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& pair : blobs) {
+                if (!pair.second.persisted) {
+                    refs.push_back(pair.first);
+                    keys.push_back(prefix + toHex(pair.first));
+                    values.push_back(std::string(pair.second.data));
+                }
+            }
+        }
+        if (keys.empty()) {
+            return;
+        }
+        adapter.saveBatch(keys, values);
+        std::lock_guard<std::mutex> lock(mutex);
+        for (ContentRef ref : refs) {
+            auto it = blobs.find(ref);
+            if (it != blobs.end()) {
+                it->second.persisted = true;
+            }
+        }
+    }
+
+    // Stage every blob stored under `prefix` with no references (see retainVersion() and prune()).
+    // Blobs already in memory are only marked as persisted
+    void load(IStorageAdapter& adapter, const std::string& prefix = KEY_PREFIX) {
+        RawPtrWrapper<IStorageCursor> cursor = adapter.scan(prefix);
+        std::string key;
+        std::string data;
+        while (cursor->next(key, data)) {
+            ContentRef ref = fromHex(std::string_view(key).substr(prefix.size()));
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = blobs.find(ref);
+            if (it == blobs.end()) {
+                Blob blob;
+                blob.data = arena.copy(data);
+                blob.persisted = true;
+                storedBytes += data.size();
+                blobs.emplace(ref, std::move(blob));
+            } else if (it->second.data != data) {
+                throw std::runtime_error("ContentBlobStore: hash collision on " + toHex(ref));
+            } else {
+                it->second.persisted = true;
+            }
+        }
+    }
+
+    // Drop the blobs staged by load() that nothing retained, and delete their stored copies
+    void prune(IStorageAdapter& adapter, const std::string& prefix = KEY_PREFIX) {
+        std::vector<std::string> keys;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto it = blobs.begin(); it != blobs.end(); ) {
+                if (it->second.refs > 0) {
+                    ++it;
+                    continue;
+                }
+                if (it->second.persisted) {
+                    keys.push_back(prefix + toHex(it->first));
+                }
+                storedBytes -= it->second.data.size();
+                deadBytes += it->second.data.size();
+                it = blobs.erase(it);
+            }
+            compactLocked();
+        }
+        if (!keys.empty()) {
+            adapter.removeMany(keys);
+        }
+    }
+
+    // History ref lists in records: a JSON array of hex refs
+    static std::string refListJSON(const std::vector<ContentRef>& refs) {
+        std::string json = "[";
+        for (std::size_t i = 0; i < refs.size(); ++i) {
+            json += (i ? ", \"" : "\"") + toHex(refs[i]) + "\"";
+        }
+        json += "]";
+        return json;
+    }
+
+    static std::vector<ContentRef> readRefList(const std::string& json) {
+        std::vector<ContentRef> refs;
+        std::size_t pos = json.find('"');
+        while (pos != std::string::npos) {
+            std::size_t end = json.find('"', pos + 1);
+            if (end == std::string::npos) {
+                throw std::invalid_argument("ContentBlobStore: malformed ref list");
+            }
+            refs.push_back(fromHex(std::string_view(json).substr(pos + 1, end - pos - 1)));
+            pos = json.find('"', end + 1);
+        }
+        return refs;
+    }
+
+    // Statistics
+    std::size_t blobCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return blobs.size();
+    }
+
+    std::size_t byteCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return storedBytes;
+    }
+
+    std::size_t arenaBytes() const {  // Live plus not yet compacted
+        std::lock_guard<std::mutex> lock(mutex);
+        return arena.bytesUsed();
+    }
+};
+
+
+
+
+#endif // __CONTENTBLOBSTORE_HPP__
@@ -7,8 +7,10 @@
 #include <vector>
 #include <ctime>
 #include <map>
+#include <cstdint>
 #include "../Enums/ArchiNoteAttributeType.hpp"
 #include "../Enums/ArchiNoteAttributeRelationType.hpp"
+#include "../ArchiNoteMemory/StringInterner.hpp"
 
 
 
@@ -18,10 +20,10 @@ struct AttributeMetadata {
     std::string id;  // Unique ID (e.g., "OBJ-001")
     ArchiNoteAttributeType type;  // Semantic category
     std::time_t timestamp;  // Creation/update time
-    std::string author;  // Who modified
+    InternedString author;  // Who modified (interned: a handful of authors over many attributes)
     bool hasAmbiguities = false;  // Ambiguity flag
     std::vector<ArchiNoteAttributeRelationType> relations;  // Semantic links
-    std::vector<void*> history;  // Generic history (raw pointers, type-erased)
+    std::vector<std::uint64_t> history;  // Version refs (ContentRef) into the owner's ContentBlobStore
     std::map<std::time_t, std::string> changeLog;  // Diff descriptions
 
     // Constructor for initialization
@@ -33,8 +35,8 @@ struct AttributeMetadata {
         : id(other.id), type(other.type), timestamp(other.timestamp), author(other.author),
           hasAmbiguities(other.hasAmbiguities), relations(other.relations),
           changeLog(other.changeLog) {
-        // Note: history requires derived class to handle specific type copying
-        history = other.history;  // Shallow copy for now, managed by derived
+        // Note: history refs are not retained here; the owning Versioned* class manages them
+        history = other.history;
     }
 
     // Move constructor
@@ -56,7 +58,7 @@ struct AttributeMetadata {
             hasAmbiguities = other.hasAmbiguities;
             relations = other.relations;
             changeLog = other.changeLog;
-            history = other.history;  // Shallow copy, managed by derived
+            history = other.history;  // Refs not retained, managed by derived
         }
         return *this;
     }
@@ -78,7 +80,7 @@ struct AttributeMetadata {
 
     // Destructor (history cleanup by derived classes)
     ~AttributeMetadata() {
-        // No delete here; derived classes manage specific types in history
+        // No release here; derived classes release their history refs
     }
 };
 
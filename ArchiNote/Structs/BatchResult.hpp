@@ -0,0 +1,35 @@
+#ifndef __BATCHRESULT_HPP__
+#define __BATCHRESULT_HPP__
+
+
+#include <string>
+#include <vector>
+#include <map>
+#include <utility>
+#include <cstddef>
+
+
+
+
+// Input of createBatch()/updateBatch(): (id, params) pairs, applied in order
+typedef std::vector<std::pair<std::string, std::map<std::string, std::string>>> AttributeBatch;
+
+// One rejected batch item
+struct BatchFailure {
+    std::size_t index;  // Position in the batch
+    std::string id;
+    std::string error;  // The message a single create()/update() would have thrown
+};
+
+// Outcome of a batch: items not listed in `failures` were applied and persisted
+struct BatchResult {
+    std::size_t succeeded = 0;
+    std::vector<BatchFailure> failures;
+
+    bool ok() const { return failures.empty(); }
+};
+
+
+
+
+#endif // __BATCHRESULT_HPP__
@@ -0,0 +1,261 @@
+#ifndef __JSONFIELDS_HPP__
+#define __JSONFIELDS_HPP__
+
+
+#include <string>
+#include <map>
+#include <vector>
+#include <utility>
+#include <cstdlib>
+#include <stdexcept>
+
+
+
+
+// Minimal JSON helpers for the flat objects produced by toJSON()/toFullJSON()
+// escape() quotes string values on the way out. readObject() reads one object level: string values
+// are unescaped, numbers/booleans are returned as their literal text, nested objects/arrays are
+// returned raw (read them with another readObject call).
+struct JSONFields {
+    static std::string escape(const std::string& text) {
+        std::string out;
+        out.reserve(text.size());
+        for (char c : text) {
+            switch (c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                case '\r': out += "\\r"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        // Other control characters are not allowed raw inside a JSON string
+                        static const char* hex = "0123456789abcdef";
+                        out += "\\u00";
+                        out += hex[(c >> 4) & 0xf];
+                        out += hex[c & 0xf];
+                    } else {
+                        out += c;
+                    }
+                    break;
+            }
+        }
+        return out;
+    }
+
+    static std::map<std::string, std::string> readObject(const std::string& json) {
+        std::map<std::string, std::string> fields;
+        std::size_t pos = 0;
+        skipSpace(json, pos);
+        expect(json, pos, '{');
+        skipSpace(json, pos);
+        if (pos < json.size() && json[pos] == '}') {
+            return fields;
+        }
+        while (true) {
+            skipSpace(json, pos);
+            std::string key = readString(json, pos);
+            skipSpace(json, pos);
+            expect(json, pos, ':');
+            skipSpace(json, pos);
+            fields[key] = readValue(json, pos);
+            skipSpace(json, pos);
+            if (pos < json.size() && json[pos] == ',') {
+                ++pos;
+                continue;
+            }
+            expect(json, pos, '}');
+            return fields;
+        }
+    }
+
+    // Like readObject(), but every value is returned as its raw JSON text (strings stay quoted and
+    // escaped) and fields keep their document order, so the object can be re-assembled verbatim.
+    static std::vector<std::pair<std::string, std::string>> readRawObject(const std::string& json) {
+        std::vector<std::pair<std::string, std::string>> fields;
+        std::size_t pos = 0;
+        skipSpace(json, pos);
+        expect(json, pos, '{');
+        skipSpace(json, pos);
+        if (pos < json.size() && json[pos] == '}') {
+            return fields;
+        }
+        while (true) {
+            skipSpace(json, pos);
+            std::string key = readString(json, pos);
+            skipSpace(json, pos);
+            expect(json, pos, ':');
+            skipSpace(json, pos);
+            std::size_t start = pos;
+            readValue(json, pos);
+            fields.emplace_back(std::move(key), json.substr(start, pos - start));
+            skipSpace(json, pos);
+            if (pos < json.size() && json[pos] == ',') {
+                ++pos;
+                continue;
+            }
+            expect(json, pos, '}');
+            return fields;
+        }
+    }
+
+    static const std::string& getString(const std::map<std::string, std::string>& fields, const std::string& name) {
+        auto it = fields.find(name);
+        if (it == fields.end()) {
+            throw std::invalid_argument("JSON field missing: " + name);
+        }
+        return it->second;
+    }
+
+    static int getInt(const std::map<std::string, std::string>& fields, const std::string& name) {
+        const std::string& text = getString(fields, name);
+        char* end = nullptr;
+        long value = std::strtol(text.c_str(), &end, 10);
+        if (text.empty() || *end != '\0') {
+            throw std::invalid_argument("JSON field is not an integer: " + name);
+        }
+        return static_cast<int>(value);
+    }
+
+    static bool getBool(const std::map<std::string, std::string>& fields, const std::string& name) {
+        const std::string& text = getString(fields, name);
+        if (text != "true" && text != "false") {
+            throw std::invalid_argument("JSON field is not a boolean: " + name);
+        }
+        return text == "true";
+    }
+
+private:
+    static void skipSpace(const std::string& json, std::size_t& pos) {
+        while (pos < json.size() && (json[pos] == ' ' || json[pos] == '\t' || json[pos] == '\n' || json[pos] == '\r')) {
+            ++pos;
+        }
+    }
+
+    static void expect(const std::string& json, std::size_t& pos, char c) {
+        if (pos >= json.size() || json[pos] != c) {
+            throw std::invalid_argument(std::string("Malformed JSON: expected '") + c + "'");
+        }
+        ++pos;
+    }
+
+    static unsigned readHex4(const std::string& json, std::size_t& pos) {
+        if (pos + 4 > json.size()) {
+            throw std::invalid_argument("Malformed JSON: truncated \\u escape");
+        }
+        unsigned value = 0;
+        for (int i = 0; i < 4; ++i) {
+            char c = json[pos++];
+            int digit = (c >= '0' && c <= '9') ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 :
+                        (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+            if (digit < 0) {
+                throw std::invalid_argument("Malformed JSON: bad \\u escape");
+            }
+            value = (value << 4) | static_cast<unsigned>(digit);
+        }
+        return value;
+    }
+
+    // After "\u": one code point, joining a UTF-16 surrogate pair
+    static unsigned readCodePoint(const std::string& json, std::size_t& pos) {
+        unsigned unit = readHex4(json, pos);
+        if (unit >= 0xD800 && unit <= 0xDBFF && json.compare(pos, 2, "\\u") == 0) {
+            std::size_t next = pos + 2;
+            unsigned low = readHex4(json, next);
+            if (low >= 0xDC00 && low <= 0xDFFF) {
+                pos = next;
+                return 0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00);
+            }
+        }
+        return unit;
+    }
+
+    static void appendUtf8(std::string& out, unsigned codePoint) {
+        if (codePoint < 0x80) {
+            out += static_cast<char>(codePoint);
+        } else if (codePoint < 0x800) {
+            out += static_cast<char>(0xC0 | (codePoint >> 6));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+            out += static_cast<char>(0xE0 | (codePoint >> 12));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (codePoint >> 18));
+            out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+
+    static std::string readString(const std::string& json, std::size_t& pos) {
+        expect(json, pos, '"');
+        std::string out;
+        while (pos < json.size() && json[pos] != '"') {
+            char c = json[pos++];
+            if (c == '\\' && pos < json.size()) {
+                char e = json[pos++];
+                switch (e) {
+                    case 'n': out += '\n'; break;
+                    case 't': out += '\t'; break;
+                    case 'r': out += '\r'; break;
+                    case 'b': out += '\b'; break;
+                    case 'f': out += '\f'; break;
+                    case 'u': appendUtf8(out, readCodePoint(json, pos)); break;
+                    default: out += e; break;  // \" \\ \/
+                }
+            } else {
+                out += c;
+            }
+        }
+        expect(json, pos, '"');
+        return out;
+    }
+
+    static std::string readValue(const std::string& json, std::size_t& pos) {
+        if (pos >= json.size()) {
+            throw std::invalid_argument("Malformed JSON: missing value");
+        }
+        if (json[pos] == '"') {
+            return readString(json, pos);
+        }
+        if (json[pos] == '{' || json[pos] == '[') {
+            // Raw nested text, tracking depth and skipping over strings
+            std::size_t start = pos;
+            int depth = 0;
+            while (pos < json.size()) {
+                char c = json[pos];
+                if (c == '"') {
+                    readString(json, pos);
+                    continue;
+                }
+                ++pos;
+                if (c == '{' || c == '[') {
+                    ++depth;
+                } else if ((c == '}' || c == ']') && --depth == 0) {
+                    return json.substr(start, pos - start);
+                }
+            }
+            throw std::invalid_argument("Malformed JSON: unterminated object");
+        }
+        std::size_t start = pos;
+        while (pos < json.size() && json[pos] != ',' && json[pos] != '}' && json[pos] != ']' &&
+               json[pos] != ' ' && json[pos] != '\t' && json[pos] != '\n' && json[pos] != '\r') {
+            ++pos;
+        }
+        return json.substr(start, pos - start);
+    }
+};
+
+
+
+
+
+
+
+
+
+
+
+
+#endif // __JSONFIELDS_HPP__
@@ -6,6 +6,8 @@
 
 
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <memory>
 #include <cstdint>  // ✅ Add this
@@ -13,25 +15,34 @@
 #include <functional>  // ✅ Add this
 #include <stdexcept> // Required for std::invalid_argument
 
+#include "../JSONFields.hpp"
 
 
+
+// Typed create/update parameters for AssumptionsContent (views into caller-owned text; empty author = unchanged)
+struct AssumptionsParams {
+    std::string_view assumption;
+    std::string_view rationale;
+    std::string_view author;
+};
+
 // Flat struct for AssumptionsContent (no inheritance, pure data + methods)
 struct AssumptionsContent {
     std::string assumption;  // e.g., "Users have high-speed internet"
     std::string rationale;  // e.g., "Based on target market data"
 
     // Static factory method (factory style)
-    static AssumptionsContent CreateAssumptionsContent(const std::string& assumption, const std::string& rationale) {
+    static AssumptionsContent CreateAssumptionsContent(std::string assumption, std::string rationale) {
         // Basic validation
         if (assumption.empty() || rationale.empty()) {
             throw std::invalid_argument("Invalid assumptions parameters: assumption or rationale empty");
         }
-        return AssumptionsContent{assumption, rationale};
+        return AssumptionsContent{std::move(assumption), std::move(rationale)};
     }
 
     // Constructor
-    AssumptionsContent(const std::string& assumption, const std::string& rationale)
-        : assumption(assumption), rationale(rationale) {}
+    AssumptionsContent(std::string assumption, std::string rationale)
+        : assumption(std::move(assumption)), rationale(std::move(rationale)) {}
 
     // Validation method (no virtual)
     bool isContentValid() const {
@@ -40,11 +51,28 @@ struct AssumptionsContent {
 
     // JSON serialization (no virtual)
     std::string toJSON() const {
-        return "{ \"assumption\": \"" + assumption + "\", \"rationale\": \"" + rationale + "\" }";
+        return "{ \"assumption\": \"" + JSONFields::escape(assumption) + "\", \"rationale\": \"" + JSONFields::escape(rationale) + "\" }";
+    }
+
+    // JSON deserialization (inverse of toJSON, validated through the factory)
+    static AssumptionsContent FromJSON(const std::string& json) {
+        auto fields = JSONFields::readObject(json);
+        return CreateAssumptionsContent(JSONFields::getString(fields, "assumption"),
+                                        JSONFields::getString(fields, "rationale"));
+    }
+
+    // Build from typed parameters (one allocation per text field, validated through the factory)
+    static AssumptionsContent FromParams(const AssumptionsParams& params) {
+        return CreateAssumptionsContent(std::string(params.assumption), std::string(params.rationale));
     }
 
     // Deep copy via copy constructor (used for history)
     AssumptionsContent(const AssumptionsContent& other) = default;
+
+    // Moves and assignment (the declared copy constructor would otherwise suppress the implicit moves)
+    AssumptionsContent(AssumptionsContent&& other) noexcept = default;
+    AssumptionsContent& operator=(const AssumptionsContent& other) = default;
+    AssumptionsContent& operator=(AssumptionsContent&& other) noexcept = default;
 };
 
 
@@ -6,6 +6,8 @@
 
 
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <memory>
 #include <cstdint>  // ✅ Add this
@@ -13,27 +15,36 @@
 #include <functional>  // ✅ Add this
 #include <stdexcept> // Required for std::invalid_argument
 
+#include "../JSONFields.hpp"
 
 
 
 
+
+// Typed create/update parameters for ConstraintContent (views into caller-owned text; empty author = unchanged)
+struct ConstraintParams {
+    std::string_view constraint;
+    std::string_view impact;
+    std::string_view author;
+};
+
 // Flat struct for ConstraintsContent (no inheritance, pure data + methods)
 struct ConstraintContent {
     std::string constraint;  // e.g., "Limited to cloud deployment"
     std::string impact;  // e.g., "Increases hosting costs"
 
     // Static factory method (factory style)
-    static ConstraintContent CreateConstraintsContent(const std::string& constraint, const std::string& impact) {
+    static ConstraintContent CreateConstraintsContent(std::string constraint, std::string impact) {
         // Basic validation
         if (constraint.empty() || impact.empty()) {
             throw std::invalid_argument("Invalid constraints parameters: constraint or impact empty");
         }
-        return ConstraintContent{constraint, impact};
+        return ConstraintContent{std::move(constraint), std::move(impact)};
     }
 
     // Constructor
-    ConstraintContent(const std::string& constraint, const std::string& impact)
-        : constraint(constraint), impact(impact) {}
+    ConstraintContent(std::string constraint, std::string impact)
+        : constraint(std::move(constraint)), impact(std::move(impact)) {}
 
     // Validation method (no virtual)
     bool isContentValid() const {
@@ -42,11 +53,28 @@ struct ConstraintContent {
 
     // JSON serialization (no virtual)
     std::string toJSON() const {
-        return "{ \"constraint\": \"" + constraint + "\", \"impact\": \"" + impact + "\" }";
+        return "{ \"constraint\": \"" + JSONFields::escape(constraint) + "\", \"impact\": \"" + JSONFields::escape(impact) + "\" }";
+    }
+
+    // JSON deserialization (inverse of toJSON, validated through the factory)
+    static ConstraintContent FromJSON(const std::string& json) {
+        auto fields = JSONFields::readObject(json);
+        return CreateConstraintsContent(JSONFields::getString(fields, "constraint"),
+                                        JSONFields::getString(fields, "impact"));
+    }
+
+    // Build from typed parameters (one allocation per text field, validated through the factory)
+    static ConstraintContent FromParams(const ConstraintParams& params) {
+        return CreateConstraintsContent(std::string(params.constraint), std::string(params.impact));
     }
 
     // Deep copy via copy constructor (used for history)
     ConstraintContent(const ConstraintContent& other) = default;
+
+    // Moves and assignment (the declared copy constructor would otherwise suppress the implicit moves)
+    ConstraintContent(ConstraintContent&& other) noexcept = default;
+    ConstraintContent& operator=(const ConstraintContent& other) = default;
+    ConstraintContent& operator=(ConstraintContent&& other) noexcept = default;
 };
 
 
@@ -6,6 +6,8 @@
 
 
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <memory>
 #include <cstdint>  // ✅ Add this
@@ -13,8 +15,18 @@
 #include <functional>  // ✅ Add this
 #include <stdexcept> // Required for std::invalid_argument
 
+#include "../JSONFields.hpp"
 
 
+
+// Typed create/update parameters for HighLevelFeatureContent (views into caller-owned text; empty author = unchanged)
+struct HighLevelFeatureParams {
+    std::string_view feature;
+    std::string_view description;
+    int priority = 0;
+    std::string_view author;
+};
+
 // Flat struct for HighLevelFeaturesContent (no inheritance, pure data + methods)
 struct HighLevelFeatureContent {
     std::string feature;  // e.g., "Real-time analytics"
@@ -22,7 +34,7 @@ struct HighLevelFeatureContent {
     int priority;  // e.g., 1-3
 
     // Static factory method (factory style)
-    static HighLevelFeatureContent CreateHighLevelFeaturesContent(const std::string& feature, const std::string& description, int priority) {
+    static HighLevelFeatureContent CreateHighLevelFeaturesContent(std::string feature, std::string description, int priority) {
         // Basic validation
         if (feature.empty() || description.empty()) {
             throw std::invalid_argument("Invalid high-level features parameters: feature or description empty");
@@ -30,12 +42,12 @@ struct HighLevelFeatureContent {
         if (priority < 1 || priority > 3) {
             throw std::invalid_argument("Invalid priority: must be between 1 and 3");
         }
-        return HighLevelFeatureContent{feature, description, priority};
+        return HighLevelFeatureContent{std::move(feature), std::move(description), priority};
     }
 
     // Constructor
-    HighLevelFeatureContent(const std::string& feature, const std::string& description, int priority)
-        : feature(feature), description(description), priority(priority) {}
+    HighLevelFeatureContent(std::string feature, std::string description, int priority)
+        : feature(std::move(feature)), description(std::move(description)), priority(priority) {}
 
     // Validation method (no virtual)
     bool isContentValid() const {
@@ -44,11 +56,29 @@ struct HighLevelFeatureContent {
 
     // JSON serialization (no virtual)
     std::string toJSON() const {
-        return "{ \"feature\": \"" + feature + "\", \"description\": \"" + description + "\", \"priority\": " + std::to_string(priority) + " }";
+        return "{ \"feature\": \"" + JSONFields::escape(feature) + "\", \"description\": \"" + JSONFields::escape(description) + "\", \"priority\": " + std::to_string(priority) + " }";
+    }
+
+    // JSON deserialization (inverse of toJSON, validated through the factory)
+    static HighLevelFeatureContent FromJSON(const std::string& json) {
+        auto fields = JSONFields::readObject(json);
+        return CreateHighLevelFeaturesContent(JSONFields::getString(fields, "feature"),
+                                              JSONFields::getString(fields, "description"),
+                                              JSONFields::getInt(fields, "priority"));
+    }
+
+    // Build from typed parameters (one allocation per text field, validated through the factory)
+    static HighLevelFeatureContent FromParams(const HighLevelFeatureParams& params) {
+        return CreateHighLevelFeaturesContent(std::string(params.feature), std::string(params.description), params.priority);
     }
 
     // Deep copy via copy constructor (used for history)
     HighLevelFeatureContent(const HighLevelFeatureContent& other) = default;
+
+    // Moves and assignment (the declared copy constructor would otherwise suppress the implicit moves)
+    HighLevelFeatureContent(HighLevelFeatureContent&& other) noexcept = default;
+    HighLevelFeatureContent& operator=(const HighLevelFeatureContent& other) = default;
+    HighLevelFeatureContent& operator=(HighLevelFeatureContent&& other) noexcept = default;
 };
 
 
@@ -4,16 +4,28 @@
 
 
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <memory>
 #include <cstdint>  // ✅ Add this
 #include <functional>  // ✅ Add this
 #include <stdexcept> // Required for std::invalid_argument
 
+#include "../JSONFields.hpp"
 
 
 
 
+
+// Typed create/update parameters for ObjectiveContent (views into caller-owned text; empty author = unchanged)
+struct ObjectiveParams {
+    std::string_view description;
+    std::string_view metric;
+    int priority = 0;
+    std::string_view author;
+};
+
 // Example specific content impl (ObjectiveContent)
 // Flat struct for ObjectiveContent (no inheritance, pure data + methods)
 struct ObjectiveContent {
@@ -22,16 +34,16 @@ struct ObjectiveContent {
     int priority;
 
     // Static factory method (factory style)
-    static ObjectiveContent CreateObjectiveContent(const std::string& desc, const std::string& met, int pri) {
+    static ObjectiveContent CreateObjectiveContent(std::string desc, std::string met, int pri) {
         if (desc.empty() || pri < 1 || pri > 3) {
             throw std::invalid_argument("Invalid objective parameters: description empty or priority out of range");
         }
-        return ObjectiveContent{desc, met, pri};
+        return ObjectiveContent{std::move(desc), std::move(met), pri};
     }
 
     // Constructor
-    ObjectiveContent(const std::string& desc, const std::string& met, int pri)
-        : description(desc), metric(met), priority(pri) {}
+    ObjectiveContent(std::string desc, std::string met, int pri)
+        : description(std::move(desc)), metric(std::move(met)), priority(pri) {}
 
     // Validation method (no virtual)
     bool isContentValid() const {
@@ -40,11 +52,29 @@ struct ObjectiveContent {
 
     // JSON serialization (no virtual)
     std::string toJSON() const {
-        return "{ \"desc\": \"" + description + "\", \"metric\": \"" + metric + "\", \"priority\": " + std::to_string(priority) + " }";
+        return "{ \"desc\": \"" + JSONFields::escape(description) + "\", \"metric\": \"" + JSONFields::escape(metric) + "\", \"priority\": " + std::to_string(priority) + " }";
+    }
+
+    // JSON deserialization (inverse of toJSON, validated through the factory)
+    static ObjectiveContent FromJSON(const std::string& json) {
+        auto fields = JSONFields::readObject(json);
+        return CreateObjectiveContent(JSONFields::getString(fields, "desc"),
+                                      JSONFields::getString(fields, "metric"),
+                                      JSONFields::getInt(fields, "priority"));
+    }
+
+    // Build from typed parameters (one allocation per text field, validated through the factory)
+    static ObjectiveContent FromParams(const ObjectiveParams& params) {
+        return CreateObjectiveContent(std::string(params.description), std::string(params.metric), params.priority);
     }
 
     // Deep copy via copy constructor (used for history)
     ObjectiveContent(const ObjectiveContent& other) = default;
+
+    // Moves and assignment (the declared copy constructor would otherwise suppress the implicit moves)
+    ObjectiveContent(ObjectiveContent&& other) noexcept = default;
+    ObjectiveContent& operator=(const ObjectiveContent& other) = default;
+    ObjectiveContent& operator=(ObjectiveContent&& other) noexcept = default;
 };
 
 
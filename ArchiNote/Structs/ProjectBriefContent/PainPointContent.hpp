@@ -8,35 +8,48 @@
 
 
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <memory>
 #include <cstdint>  // ✅ Add this
 #include <functional>  // ✅ Add this
 #include <stdexcept> // Required for std::invalid_argument
 
+#include "../JSONFields.hpp"
+#include "../../ArchiNoteMemory/StringInterner.hpp"
 
 
 
 
 
+
+// Typed create/update parameters for PainPointContent (views into caller-owned text; empty author = unchanged)
+struct PainPointParams {
+    std::string_view issue;
+    std::string_view impact;
+    std::string_view stakeholders;
+    std::string_view author;
+};
+
 // Flat struct for PainPointsContent (no inheritance, pure data + methods)
 struct PainPointContent {
     std::string issue;  // e.g., "Slow performance"
     std::string impact;  // e.g., "Reduces user satisfaction"
-    std::string stakeholders;  // e.g., "End users, Dev team"
+    InternedString stakeholders;  // e.g., "End users, Dev team" (interned: few distinct values)
 
     // Static factory method (factory style)
-    static PainPointContent CreatePainPointsContent(const std::string& issue, const std::string& impact, const std::string& stakeholders) {
+    static PainPointContent CreatePainPointsContent(std::string issue, std::string impact, std::string_view stakeholders) {
         // Basic validation
         if (issue.empty() || impact.empty()) {
             throw std::invalid_argument("Invalid pain points parameters: issue or impact empty");
         }
-        return PainPointContent{issue, impact, stakeholders};
+        return PainPointContent{std::move(issue), std::move(impact), InternedString(stakeholders)};
     }
 
     // Constructor
-    PainPointContent(const std::string& issue, const std::string& impact, const std::string& stakeholders)
-        : issue(issue), impact(impact), stakeholders(stakeholders) {}
+    PainPointContent(std::string issue, std::string impact, InternedString stakeholders)
+        : issue(std::move(issue)), impact(std::move(impact)), stakeholders(stakeholders) {}
 
     // Validation method (no virtual)
     bool isContentValid() const {
@@ -45,11 +58,30 @@ struct PainPointContent {
 
     // JSON serialization (no virtual)
     std::string toJSON() const {
-        return "{ \"issue\": \"" + issue + "\", \"impact\": \"" + impact + "\", \"stakeholders\": \"" + stakeholders + "\" }";
+        return "{ \"issue\": \"" + JSONFields::escape(issue) + "\", \"impact\": \"" + JSONFields::escape(impact) + "\", \"stakeholders\": \"" + JSONFields::escape(stakeholders) + "\" }";
+    }
+
+    // JSON deserialization (inverse of toJSON, validated through the factory)
+    static PainPointContent FromJSON(const std::string& json) {
+        auto fields = JSONFields::readObject(json);
+        return CreatePainPointsContent(JSONFields::getString(fields, "issue"),
+                                       JSONFields::getString(fields, "impact"),
+                                       JSONFields::getString(fields, "stakeholders"));
+    }
+
+    // Build from typed parameters (one allocation per free-text field; the interned field is looked
+    // up straight from its view, validated through the factory)
+    static PainPointContent FromParams(const PainPointParams& params) {
+        return CreatePainPointsContent(std::string(params.issue), std::string(params.impact), params.stakeholders);
     }
 
     // Deep copy via copy constructor (used for history)
     PainPointContent(const PainPointContent& other) = default;
+
+    // Moves and assignment (the declared copy constructor would otherwise suppress the implicit moves)
+    PainPointContent(PainPointContent&& other) noexcept = default;
+    PainPointContent& operator=(const PainPointContent& other) = default;
+    PainPointContent& operator=(PainPointContent&& other) noexcept = default;
 };
 
 
@@ -3,6 +3,8 @@
 
 
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <map>
 #include <time.h>
@@ -13,8 +15,18 @@
 #include <functional>  // ✅ Add this
 #include <stdexcept> // Required for std::invalid_argument
 
+#include "../JSONFields.hpp"
 
 
+
+// Typed create/update parameters for ProjectOverviewContent (views into caller-owned text; empty author = unchanged)
+struct ProjectOverviewParams {
+    std::string_view title;
+    std::string_view brief;
+    std::string_view date;
+    std::string_view author;
+};
+
 // Flat struct for ProjectOverviewContent (no inheritance, pure data + methods)
 struct ProjectOverviewContent {
     std::string title;
@@ -22,7 +34,7 @@ struct ProjectOverviewContent {
     std::string date;  // Format: YYYY-MM-DD, e.g., "2025-09-14"
 
     // Static factory method (factory style)
-    static ProjectOverviewContent CreateProjectOverviewContent(const std::string& title, const std::string& brief, const std::string& date) {
+    static ProjectOverviewContent CreateProjectOverviewContent(std::string title, std::string brief, std::string date) {
         // Basic validation
         if (title.empty() || brief.empty()) {
             throw std::invalid_argument("Invalid project overview parameters: title or brief empty");
@@ -31,12 +43,12 @@ struct ProjectOverviewContent {
         if (date.length() != 10 || date[4] != '-' || date[7] != '-') {
             throw std::invalid_argument("Invalid date format: expected YYYY-MM-DD");
         }
-        return ProjectOverviewContent{title, brief, date};
+        return ProjectOverviewContent{std::move(title), std::move(brief), std::move(date)};
     }
 
     // Constructor
-    ProjectOverviewContent(const std::string& title, const std::string& brief, const std::string& date)
-        : title(title), brief(brief), date(date) {}
+    ProjectOverviewContent(std::string title, std::string brief, std::string date)
+        : title(std::move(title)), brief(std::move(brief)), date(std::move(date)) {}
 
     // Validation method (no virtual)
     bool isContentValid() const {
@@ -45,11 +57,29 @@ struct ProjectOverviewContent {
 
     // JSON serialization (no virtual)
     std::string toJSON() const {
-        return "{ \"title\": \"" + title + "\", \"brief\": \"" + brief + "\", \"date\": \"" + date + "\" }";
+        return "{ \"title\": \"" + JSONFields::escape(title) + "\", \"brief\": \"" + JSONFields::escape(brief) + "\", \"date\": \"" + JSONFields::escape(date) + "\" }";
+    }
+
+    // JSON deserialization (inverse of toJSON, validated through the factory)
+    static ProjectOverviewContent FromJSON(const std::string& json) {
+        auto fields = JSONFields::readObject(json);
+        return CreateProjectOverviewContent(JSONFields::getString(fields, "title"),
+                                            JSONFields::getString(fields, "brief"),
+                                            JSONFields::getString(fields, "date"));
+    }
+
+    // Build from typed parameters (one allocation per text field, validated through the factory)
+    static ProjectOverviewContent FromParams(const ProjectOverviewParams& params) {
+        return CreateProjectOverviewContent(std::string(params.title), std::string(params.brief), std::string(params.date));
     }
 
     // Deep copy via copy constructor (used for history)
     ProjectOverviewContent(const ProjectOverviewContent& other) = default;
+
+    // Moves and assignment (the declared copy constructor would otherwise suppress the implicit moves)
+    ProjectOverviewContent(ProjectOverviewContent&& other) noexcept = default;
+    ProjectOverviewContent& operator=(const ProjectOverviewContent& other) = default;
+    ProjectOverviewContent& operator=(ProjectOverviewContent&& other) noexcept = default;
 };
 
 
@@ -5,6 +5,8 @@
 
 
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <memory>
 #include <cstdint>  // ✅ Add this
@@ -12,19 +14,30 @@
 #include <functional>  // ✅ Add this
 #include <stdexcept> // Required for std::invalid_argument
 
+#include "../JSONFields.hpp"
+#include "../../ArchiNoteMemory/StringInterner.hpp"
 
 
 
 
 
+
+// Typed create/update parameters for ReviewChecklistContent (views into caller-owned text; empty author = unchanged)
+struct ReviewChecklistParams {
+    std::string_view item;
+    bool isChecked = false;
+    std::string_view status;
+    std::string_view author;
+};
+
 // Flat struct for ReviewChecklistContent (no inheritance, pure data + methods)
 struct ReviewChecklistContent {
     std::string item;  // e.g., "Objectives are measurable"
     bool isChecked;  // e.g., true/false
-    std::string status;  // e.g., "Pass/Fail/Pending"
+    InternedString status;  // e.g., "Pass/Fail/Pending" (interned: few distinct values)
 
     // Static factory method (factory style)
-    static ReviewChecklistContent CreateReviewChecklistContent(const std::string& item, bool isChecked, const std::string& status) {
+    static ReviewChecklistContent CreateReviewChecklistContent(std::string item, bool isChecked, std::string_view status) {
         // Basic validation
         if (item.empty()) {
             throw std::invalid_argument("Invalid review checklist parameters: item empty");
@@ -32,12 +45,12 @@ struct ReviewChecklistContent {
         if (status != "Pass" && status != "Fail" && status != "Pending") {
             throw std::invalid_argument("Invalid status: must be Pass, Fail, or Pending");
         }
-        return ReviewChecklistContent{item, isChecked, status};
+        return ReviewChecklistContent{std::move(item), isChecked, InternedString(status)};
     }
 
     // Constructor
-    ReviewChecklistContent(const std::string& item, bool isChecked, const std::string& status)
-        : item(item), isChecked(isChecked), status(status) {}
+    ReviewChecklistContent(std::string item, bool isChecked, InternedString status)
+        : item(std::move(item)), isChecked(isChecked), status(status) {}
 
     // Validation method (no virtual)
     bool isContentValid() const {
@@ -46,11 +59,30 @@ struct ReviewChecklistContent {
 
     // JSON serialization (no virtual)
     std::string toJSON() const {
-        return "{ \"item\": \"" + item + "\", \"isChecked\": " + (isChecked ? "true" : "false") + ", \"status\": \"" + status + "\" }";
+        return "{ \"item\": \"" + JSONFields::escape(item) + "\", \"isChecked\": " + (isChecked ? "true" : "false") + ", \"status\": \"" + JSONFields::escape(status) + "\" }";
+    }
+
+    // JSON deserialization (inverse of toJSON, validated through the factory)
+    static ReviewChecklistContent FromJSON(const std::string& json) {
+        auto fields = JSONFields::readObject(json);
+        return CreateReviewChecklistContent(JSONFields::getString(fields, "item"),
+                                            JSONFields::getBool(fields, "isChecked"),
+                                            JSONFields::getString(fields, "status"));
+    }
+
+    // Build from typed parameters (one allocation per free-text field; the interned field is looked
+    // up straight from its view, validated through the factory)
+    static ReviewChecklistContent FromParams(const ReviewChecklistParams& params) {
+        return CreateReviewChecklistContent(std::string(params.item), params.isChecked, params.status);
     }
 
     // Deep copy via copy constructor (used for history)
     ReviewChecklistContent(const ReviewChecklistContent& other) = default;
+
+    // Moves and assignment (the declared copy constructor would otherwise suppress the implicit moves)
+    ReviewChecklistContent(ReviewChecklistContent&& other) noexcept = default;
+    ReviewChecklistContent& operator=(const ReviewChecklistContent& other) = default;
+    ReviewChecklistContent& operator=(ReviewChecklistContent&& other) noexcept = default;
 };
 
 
@@ -8,6 +8,8 @@
 
 
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <memory>
 #include <cstdint>  // ✅ Add this
@@ -15,9 +17,19 @@
 #include <functional>  // ✅ Add this
 #include <stdexcept> // Required for std::invalid_argument
 
+#include "../JSONFields.hpp"
 
 
 
+
+// Typed create/update parameters for RiskContent (views into caller-owned text; empty author = unchanged)
+struct RiskParams {
+    std::string_view riskDescription;
+    std::string_view impact;
+    std::string_view mitigation;
+    std::string_view author;
+};
+
 // Flat struct for RiskContent (no inheritance, pure data + methods)
 struct RiskContent {
     std::string riskDescription;  // e.g., "Potential server downtime"
@@ -25,17 +37,17 @@ struct RiskContent {
     std::string mitigation;  // e.g., "Implement redundant servers"
 
     // Static factory method (factory style)
-    static RiskContent CreateRiskContent(const std::string& riskDescription, const std::string& impact, const std::string& mitigation) {
+    static RiskContent CreateRiskContent(std::string riskDescription, std::string impact, std::string mitigation) {
         // Basic validation
         if (riskDescription.empty() || impact.empty()) {
             throw std::invalid_argument("Invalid risk parameters: riskDescription or impact empty");
         }
-        return RiskContent{riskDescription, impact, mitigation};
+        return RiskContent{std::move(riskDescription), std::move(impact), std::move(mitigation)};
     }
 
     // Constructor
-    RiskContent(const std::string& riskDescription, const std::string& impact, const std::string& mitigation)
-        : riskDescription(riskDescription), impact(impact), mitigation(mitigation) {}
+    RiskContent(std::string riskDescription, std::string impact, std::string mitigation)
+        : riskDescription(std::move(riskDescription)), impact(std::move(impact)), mitigation(std::move(mitigation)) {}
 
     // Validation method (no virtual)
     bool isContentValid() const {
@@ -44,11 +56,29 @@ struct RiskContent {
 
     // JSON serialization (no virtual)
     std::string toJSON() const {
-        return "{ \"riskDescription\": \"" + riskDescription + "\", \"impact\": \"" + impact + "\", \"mitigation\": \"" + mitigation + "\" }";
+        return "{ \"riskDescription\": \"" + JSONFields::escape(riskDescription) + "\", \"impact\": \"" + JSONFields::escape(impact) + "\", \"mitigation\": \"" + JSONFields::escape(mitigation) + "\" }";
+    }
+
+    // JSON deserialization (inverse of toJSON, validated through the factory)
+    static RiskContent FromJSON(const std::string& json) {
+        auto fields = JSONFields::readObject(json);
+        return CreateRiskContent(JSONFields::getString(fields, "riskDescription"),
+                                 JSONFields::getString(fields, "impact"),
+                                 JSONFields::getString(fields, "mitigation"));
+    }
+
+    // Build from typed parameters (one allocation per text field, validated through the factory)
+    static RiskContent FromParams(const RiskParams& params) {
+        return CreateRiskContent(std::string(params.riskDescription), std::string(params.impact), std::string(params.mitigation));
     }
 
     // Deep copy via copy constructor (used for history)
     RiskContent(const RiskContent& other) = default;
+
+    // Moves and assignment (the declared copy constructor would otherwise suppress the implicit moves)
+    RiskContent(RiskContent&& other) noexcept = default;
+    RiskContent& operator=(const RiskContent& other) = default;
+    RiskContent& operator=(RiskContent&& other) noexcept = default;
 };
 
 
@@ -6,6 +6,8 @@
 
 
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <memory>
 #include <cstdint>  // ✅ Add this
@@ -13,26 +15,37 @@
 #include <functional>  // ✅ Add this
 #include <stdexcept> // Required for std::invalid_argument
 
+#include "../JSONFields.hpp"
+#include "../../ArchiNoteMemory/StringInterner.hpp"
 
 
+
+// Typed create/update parameters for SuccessMetricContent (views into caller-owned text; empty author = unchanged)
+struct SuccessMetricParams {
+    std::string_view metric;
+    std::string_view target;
+    std::string_view timeframe;
+    std::string_view author;
+};
+
 // Flat struct for SuccessMetricsContent (no inheritance, pure data + methods)
 struct SuccessMetricContent {
     std::string metric;  // e.g., "User retention rate"
     std::string target;  // e.g., "80% retention after 3 months"
-    std::string timeframe;  // e.g., "Q1 2026"
+    InternedString timeframe;  // e.g., "Q1 2026" (interned: few distinct values)
 
     // Static factory method (factory style)
-    static SuccessMetricContent CreateSuccessMetricsContent(const std::string& metric, const std::string& target, const std::string& timeframe) {
+    static SuccessMetricContent CreateSuccessMetricsContent(std::string metric, std::string target, std::string_view timeframe) {
         // Basic validation
         if (metric.empty() || target.empty()) {
             throw std::invalid_argument("Invalid success metrics parameters: metric or target empty");
         }
-        return SuccessMetricContent{metric, target, timeframe};
+        return SuccessMetricContent{std::move(metric), std::move(target), InternedString(timeframe)};
     }
 
     // Constructor
-    SuccessMetricContent(const std::string& metric, const std::string& target, const std::string& timeframe)
-        : metric(metric), target(target), timeframe(timeframe) {}
+    SuccessMetricContent(std::string metric, std::string target, InternedString timeframe)
+        : metric(std::move(metric)), target(std::move(target)), timeframe(timeframe) {}
 
     // Validation method (no virtual)
     bool isContentValid() const {
@@ -41,11 +54,30 @@ struct SuccessMetricContent {
 
     // JSON serialization (no virtual)
     std::string toJSON() const {
-        return "{ \"metric\": \"" + metric + "\", \"target\": \"" + target + "\", \"timeframe\": \"" + timeframe + "\" }";
+        return "{ \"metric\": \"" + JSONFields::escape(metric) + "\", \"target\": \"" + JSONFields::escape(target) + "\", \"timeframe\": \"" + JSONFields::escape(timeframe) + "\" }";
+    }
+
+    // JSON deserialization (inverse of toJSON, validated through the factory)
+    static SuccessMetricContent FromJSON(const std::string& json) {
+        auto fields = JSONFields::readObject(json);
+        return CreateSuccessMetricsContent(JSONFields::getString(fields, "metric"),
+                                           JSONFields::getString(fields, "target"),
+                                           JSONFields::getString(fields, "timeframe"));
+    }
+
+    // Build from typed parameters (one allocation per free-text field; the interned field is looked
+    // up straight from its view, validated through the factory)
+    static SuccessMetricContent FromParams(const SuccessMetricParams& params) {
+        return CreateSuccessMetricsContent(std::string(params.metric), std::string(params.target), params.timeframe);
     }
 
     // Deep copy via copy constructor (used for history)
     SuccessMetricContent(const SuccessMetricContent& other) = default;
+
+    // Moves and assignment (the declared copy constructor would otherwise suppress the implicit moves)
+    SuccessMetricContent(SuccessMetricContent&& other) noexcept = default;
+    SuccessMetricContent& operator=(const SuccessMetricContent& other) = default;
+    SuccessMetricContent& operator=(SuccessMetricContent&& other) noexcept = default;
 };
 
 
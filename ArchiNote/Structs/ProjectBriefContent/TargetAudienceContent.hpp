@@ -7,33 +7,46 @@
 
 
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <memory>
 #include <cstdint>  // ✅ Add this
 #include <functional>  // ✅ Add this
 #include <stdexcept> // Required for std::invalid_argument
 
+#include "../JSONFields.hpp"
+#include "../../ArchiNoteMemory/StringInterner.hpp"
 
 
 
+
+// Typed create/update parameters for TargetAudienceContent (views into caller-owned text; empty author = unchanged)
+struct TargetAudienceParams {
+    std::string_view audienceSegment;
+    std::string_view needs;
+    std::string_view characteristics;
+    std::string_view author;
+};
+
 // Flat struct for TargetAudienceContent (no inheritance, pure data + methods)
 struct TargetAudienceContent {
-    std::string audienceSegment;  // e.g., "Developers"
+    InternedString audienceSegment;  // e.g., "Developers" (interned: few distinct values)
     std::string needs;  // e.g., "Scalable tools"
     std::string characteristics;  // e.g., "Tech-savvy"
 
     // Static factory method (factory style)
-    static TargetAudienceContent CreateTargetAudienceContent(const std::string& segment, const std::string& needs, const std::string& characteristics) {
+    static TargetAudienceContent CreateTargetAudienceContent(std::string_view segment, std::string needs, std::string characteristics) {
         // Basic validation
         if (segment.empty() || needs.empty()) {
             throw std::invalid_argument("Invalid target audience parameters: segment or needs empty");
         }
-        return TargetAudienceContent{segment, needs, characteristics};
+        return TargetAudienceContent{InternedString(segment), std::move(needs), std::move(characteristics)};
     }
 
     // Constructor
-    TargetAudienceContent(const std::string& segment, const std::string& needs, const std::string& characteristics)
-        : audienceSegment(segment), needs(needs), characteristics(characteristics) {}
+    TargetAudienceContent(InternedString segment, std::string needs, std::string characteristics)
+        : audienceSegment(segment), needs(std::move(needs)), characteristics(std::move(characteristics)) {}
 
     // Validation method (no virtual)
     bool isContentValid() const {
@@ -42,11 +55,30 @@ struct TargetAudienceContent {
 
     // JSON serialization (no virtual)
     std::string toJSON() const {
-        return "{ \"segment\": \"" + audienceSegment + "\", \"needs\": \"" + needs + "\", \"characteristics\": \"" + characteristics + "\" }";
+        return "{ \"segment\": \"" + JSONFields::escape(audienceSegment) + "\", \"needs\": \"" + JSONFields::escape(needs) + "\", \"characteristics\": \"" + JSONFields::escape(characteristics) + "\" }";
+    }
+
+    // JSON deserialization (inverse of toJSON, validated through the factory)
+    static TargetAudienceContent FromJSON(const std::string& json) {
+        auto fields = JSONFields::readObject(json);
+        return CreateTargetAudienceContent(JSONFields::getString(fields, "segment"),
+                                           JSONFields::getString(fields, "needs"),
+                                           JSONFields::getString(fields, "characteristics"));
+    }
+
+    // Build from typed parameters (one allocation per free-text field; the interned field is looked
+    // up straight from its view, validated through the factory)
+    static TargetAudienceContent FromParams(const TargetAudienceParams& params) {
+        return CreateTargetAudienceContent(params.audienceSegment, std::string(params.needs), std::string(params.characteristics));
     }
 
     // Deep copy via copy constructor (used for history)
     TargetAudienceContent(const TargetAudienceContent& other) = default;
+
+    // Moves and assignment (the declared copy constructor would otherwise suppress the implicit moves)
+    TargetAudienceContent(TargetAudienceContent&& other) noexcept = default;
+    TargetAudienceContent& operator=(const TargetAudienceContent& other) = default;
+    TargetAudienceContent& operator=(TargetAudienceContent&& other) noexcept = default;
 };
 
 
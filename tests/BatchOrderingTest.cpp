@@ -0,0 +1,104 @@
+// A batch racing single-record update/remove on the same ids: whatever order they land in, the
+// stored record of every id must end up equal to the agent's current state (absent if removed).
+// Before batches held their shard locks through saveBatch(), a slow saveBatch() could write the
+// batch's older state over a newer update, or bring back a record removed in between
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ArchiNote/ArchiNoteAttributeRepoAgent/ProjectBriefAttributeRepoAgent/ConstraintsRepoAgent.hpp"
+#include "TestSupport.hpp"
+
+
+// In-memory store whose saveBatch() is slow, to widen the window between applying a batch and
+// writing it
+class SlowBatchStorageAdapter : public IStorageAdapter {
+private:
+    std::mutex mutex;
+    std::map<std::string, std::string> records;
+
+public:
+    void save(const std::string& key, const std::string& data) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        records[key] = data;
+    }
+
+    std::string load(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = records.find(key);
+        return it != records.end() ? it->second : std::string();
+    }
+
+    void remove(const std::string& key) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        records.erase(key);
+    }
+
+    void saveBatch(const std::vector<std::string>& keys, const std::vector<std::string>& values) override {
+        std::this_thread::sleep_for(std::chrono::microseconds(300));
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            records[keys[i]] = values[i];
+        }
+    }
+};
+
+int main() {
+    const int RECORDS = 32;
+    SlowBatchStorageAdapter store;
+    ConstraintsRepoAgent agent(&store);
+    agent.enableSnapshots();  // Batches publish too: the snapshot must agree with the store
+    for (int i = 0; i < RECORDS; ++i) {
+        agent.create("c" + std::to_string(i), {{"constraint", "initial"}, {"impact", "i"}});
+    }
+
+    std::atomic<bool> done{false};
+    std::thread batches([&] {
+        for (int round = 0; round < 300; ++round) {
+            AttributeBatch batch;
+            for (int i = 0; i < RECORDS; ++i) {
+                batch.push_back({"c" + std::to_string(i), {{"constraint", "batch " + std::to_string(round)}, {"impact", "i"}}});
+            }
+            agent.updateBatch(batch);  // Removed ids fail individually
+        }
+        done = true;
+    });
+    std::thread singles([&] {
+        unsigned state = 1;
+        while (!done) {
+            state = state * 1103515245 + 12345;
+            std::string id = "c" + std::to_string((state >> 8) % RECORDS);
+            try {
+                if ((state >> 4) % 3 == 0) {
+                    agent.remove(id);
+                } else if (agent.contains(id)) {
+                    agent.update(id, {{"constraint", "single"}, {"impact", "i"}});
+                } else {
+                    agent.create(id, {{"constraint", "recreated"}, {"impact", "i"}});
+                }
+            } catch (const std::invalid_argument&) {
+                // Lost a race with the other thread's remove/create
+            }
+        }
+    });
+    batches.join();
+    singles.join();
+
+    AttributeSnapshotReader snapshot = agent.snapshot();
+    for (int i = 0; i < RECORDS; ++i) {
+        std::string id = "c" + std::to_string(i);
+        if (agent.contains(id)) {
+            CHECK(store.load(id) == agent.toJSON(id));
+            CHECK(snapshot->find(id) && *snapshot->find(id) == agent.toJSON(id));
+        } else {
+            CHECK(store.load(id).empty());
+            CHECK(!snapshot->find(id));
+        }
+    }
+    return testResult("BatchOrderingTest");
+}
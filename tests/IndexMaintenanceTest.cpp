@@ -0,0 +1,206 @@
+// Index maintenance under update and remove: the radix trie and the inverted index against plain
+// reference containers, then the completion, text and secondary indexes as the agents keep them
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "ArchiNote/ArchiNoteIndex/RadixTrie.hpp"
+#include "ArchiNote/ArchiNoteIndex/InvertedIndex.hpp"
+#include "ArchiNote/ArchiNoteManager/ProjectBriefManager/ProjectBriefArchiNoteManager.hpp"
+#include "TestSupport.hpp"
+
+
+// Byte order, as the trie enumerates keys
+static bool byteLess(const std::string& a, const std::string& b) {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+                                        [](char x, char y) { return static_cast<unsigned char>(x) < static_cast<unsigned char>(y); });
+}
+
+static void testRadixTrie() {
+    std::mt19937 rng(3);
+    RadixTrie<std::string> trie;
+    std::multimap<std::string, std::string> reference;
+    auto randomKey = [&rng] {
+        std::string key;
+        for (int length = rng() % 7; length > 0; --length) {
+            key += "ab-c\xc3"[rng() % 5];  // Shared prefixes, splits and a non-ASCII byte
+        }
+        return key;
+    };
+
+    for (int round = 0; round < 20000; ++round) {
+        std::string key = randomKey();
+        std::string value = std::to_string(rng() % 3);
+        if (rng() % 3 != 0) {
+            trie.insert(key, value);
+            reference.emplace(key, value);
+        } else {
+            bool present = false;
+            auto range = reference.equal_range(key);
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == value) {
+                    reference.erase(it);
+                    present = true;
+                    break;
+                }
+            }
+            CHECK(trie.erase(key, value) == present);
+        }
+        if (round % 101 == 0) {
+            std::string prefix = randomKey().substr(0, rng() % 3);
+            std::size_t limit = rng() % 20;
+            std::vector<std::string> expected;
+            for (const auto& entry : reference) {
+                if (entry.first.compare(0, prefix.size(), prefix) == 0) {
+                    expected.push_back(entry.first);
+                }
+            }
+            std::sort(expected.begin(), expected.end(), byteLess);
+            expected.resize(std::min(limit, expected.size()));
+            std::vector<std::string> keys;
+            for (const auto& match : trie.complete(prefix, limit)) {
+                keys.push_back(match.first);
+            }
+            CHECK(keys == expected);
+            CHECK(trie.size() == reference.size());
+        }
+    }
+    while (!reference.empty()) {
+        CHECK(trie.erase(reference.begin()->first, reference.begin()->second));
+        reference.erase(reference.begin());
+    }
+    CHECK(trie.size() == 0);
+    CHECK(trie.nodeCount() == 1);  // Erases merge and prune down to the root
+}
+
+static void testInvertedIndex() {
+    std::mt19937 rng(7);
+    const char* words[] = {"server", "downtime", "cache", "latency", "Redundant", "alpha", "beta", "x"};
+    InvertedIndex index;
+    // (owner, id) -> lower-case terms; owners 0 and 1 reuse the same ids
+    std::map<std::pair<InvertedIndex::Owner, std::string>, std::set<std::string>> reference;
+
+    for (int round = 0; round < 20000; ++round) {
+        InvertedIndex::Owner owner = rng() % 2;
+        std::string id = "D" + std::to_string(rng() % 500);
+        if (rng() % 10 < 7) {
+            std::string text;
+            std::set<std::string> terms;
+            for (int n = 1 + rng() % 5; n > 0; --n) {
+                std::string word = words[rng() % 8];
+                text += word + ", ";
+                std::transform(word.begin(), word.end(), word.begin(), [](unsigned char ch) { return std::tolower(ch); });
+                terms.insert(word);
+            }
+            index.update(id, text, owner);
+            reference[{owner, id}] = terms;
+        } else {
+            index.remove(id, owner);
+            reference.erase({owner, id});
+        }
+        if (round % 499 == 0) {
+            std::string term = words[rng() % 8];
+            std::transform(term.begin(), term.end(), term.begin(), [](unsigned char ch) { return std::tolower(ch); });
+            std::multiset<std::string> expected;
+            for (const auto& entry : reference) {
+                if (entry.second.count(term) != 0) {
+                    expected.insert(entry.first.second);
+                }
+            }
+            std::vector<std::string> matches = index.matchAny(term);
+            CHECK(std::multiset<std::string>(matches.begin(), matches.end()) == expected);
+        }
+    }
+    CHECK(index.documentCount() == reference.size());
+    CHECK(index.matchAll("server nosuchterm").empty());
+}
+
+// Two agents of one manager share the text and completion indexes and reuse the same id
+static void testSharedIndexOwners() {
+    ProjectBriefArchiNoteManager manager;
+    IAttributeRepoAgent* constraints = manager.getRepoAgent(ArchiNoteAttributeType::CONSTRAINTS);
+    IAttributeRepoAgent* risks = manager.getRepoAgent(ArchiNoteAttributeType::INITIAL_RISKS);
+    constraints->create("x", {{"constraint", "alpha budget"}, {"impact", "i"}});
+    risks->create("x", {{"riskDescription", "alpha storm"}, {"impact", "i"}, {"mitigation", "m"}});
+    CHECK(manager.searchAll("alpha").size() == 2);
+
+    risks->remove("x");  // Must leave the constraint's entries alone
+    CHECK(manager.searchAll("alpha").size() == 1);
+    CHECK(manager.searchAll("budget").size() == 1);
+    CHECK(manager.searchAll("storm").empty());
+    CHECK(manager.completeId("x").size() == 1);
+
+    risks->create("x", {{"riskDescription", "alpha storm"}, {"impact", "i"}, {"mitigation", "m"}});
+    constraints->setFullTextIndex(nullptr);
+    constraints->setCompletionIndex(nullptr);
+    CHECK(manager.searchAll("alpha").size() == 1);
+    CHECK(manager.searchAll("storm").size() == 1);
+    CHECK(manager.completeId("x").size() == 1);
+    risks->remove("x");
+    CHECK(manager.completeId("x").empty());
+}
+
+static void testCompletionAndTextUpdates() {
+    ProjectBriefArchiNoteManager manager;
+    IAttributeRepoAgent* features = manager.getRepoAgent(ArchiNoteAttributeType::HIGH_LEVEL_FEATURES);
+    features->create("HLF-1", {{"feature", "Realtime Analytics"}, {"description", "server push"}, {"priority", "1"}});
+    features->create("HLF-2", {{"feature", "Reporting"}, {"description", "d"}, {"priority", "1"}});
+    CHECK((manager.completeId("HLF") == std::vector<std::string>{"HLF-1", "HLF-2"}));
+    CHECK(manager.completeTitle("re").size() == 2);
+    CHECK(manager.searchAny("server").size() == 1);
+
+    features->update("HLF-1", {{"feature", "Dashboards"}, {"description", "d"}, {"priority", "1"}});
+    CHECK(manager.completeTitle("re").size() == 1);
+    CHECK(manager.completeTitle("dash").size() == 1 && manager.completeTitle("dash")[0].id == "HLF-1");
+    CHECK(manager.searchAny("server").empty());
+
+    features->remove("HLF-2");
+    CHECK(manager.completeTitle("re").empty());
+    CHECK(manager.completeId("HLF").size() == 1);
+
+    manager.removeAgent(ArchiNoteAttributeType::HIGH_LEVEL_FEATURES);
+    CHECK(manager.completeId("HLF").empty());
+    CHECK(manager.completeTitle("").empty());
+}
+
+static void testSecondaryIndexes() {
+    ObjectivesRepoAgent objectives;
+    for (int i = 0; i < 300; ++i) {
+        objectives.create("O" + std::to_string(i), {{"description", "d"}, {"metric", "m"},
+                                                    {"priority", std::to_string(i % 3 + 1)},
+                                                    {"author", i % 2 ? "alice" : "bob"}});
+    }
+    CHECK_THROWS(objectives.findByPriority(1), std::runtime_error);  // Off until enabled
+    objectives.enableSecondaryIndexes();
+    CHECK(objectives.findByPriority(1).size() == 100);
+    CHECK(objectives.findByAuthor("alice").size() == 150);
+
+    objectives.update("O0", {{"description", "d"}, {"metric", "m"}, {"priority", "3"}, {"author", "carol"}});
+    CHECK(objectives.findByPriority(1).size() == 99);
+    CHECK(objectives.findByPriority(3).size() == 101);
+    CHECK(objectives.findByAuthor("bob").size() == 149);
+    CHECK(objectives.findByAuthor("carol").size() == 1);
+
+    objectives.remove("O3");
+    CHECK(objectives.findByPriority(1).size() == 98);
+    CHECK(objectives.findByAuthor("alice").size() == 149);
+
+    objectives.disableSecondaryIndexes();
+    objectives.enableSecondaryIndexes();  // Rebuilt from the current records
+    CHECK(objectives.findByPriority(1).size() == 98);
+    CHECK(objectives.findByAuthor("carol").size() == 1);
+}
+
+int main() {
+    testRadixTrie();
+    testInvertedIndex();
+    testSharedIndexOwners();
+    testCompletionAndTextUpdates();
+    testSecondaryIndexes();
+    return testResult("IndexMaintenanceTest");
+}
@@ -0,0 +1,165 @@
+// Every kernel at every dispatch level this CPU supports, checked row by row against the scalar
+// level on the same random columns, plus the SelectionBitmap combinators and ColumnarSnapshot filters
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ArchiNote/ArchiNoteAnalytics/PredicateKernels.hpp"
+#include "ArchiNote/ArchiNoteAnalytics/SelectionBitmap.hpp"
+#include "ArchiNote/ArchiNoteAttributeRepoAgent/ProjectBriefAttributeRepoAgent/HighLevelFeaturesRepoAgent.hpp"
+#include "TestSupport.hpp"
+
+
+static const SimdLevel LEVELS[] = {SimdLevel::SCALAR, SimdLevel::SSE42, SimdLevel::AVX2};
+
+// Random columns of n rows. Small value ranges so ranges and equality hit often; occasional
+// extreme values exercise the signed comparisons
+struct Columns {
+    std::vector<std::int32_t> int32s;
+    std::vector<std::int64_t> int64s;
+    std::vector<std::uint32_t> codes;
+    std::vector<std::uint8_t> flags;
+    std::string blob;
+    std::vector<std::uint32_t> offsets{0};
+
+    Columns(std::size_t n, std::mt19937& rng) : int32s(n), int64s(n), codes(n), flags(n) {
+        const char alphabet[] = "abab ";
+        for (std::size_t i = 0; i < n; ++i) {
+            int32s[i] = rng() % 5 == 0 ? static_cast<std::int32_t>(rng()) : static_cast<std::int32_t>(rng() % 7) - 3;
+            int64s[i] = rng() % 5 == 0 ? static_cast<std::int64_t>((std::uint64_t(rng()) << 32) | rng())
+                                       : static_cast<std::int64_t>(rng() % 9) - 4;
+            codes[i] = rng() % 4;
+            flags[i] = rng() % 3 == 0 ? 0 : static_cast<std::uint8_t>(rng());
+            for (std::size_t length = rng() % 12; length > 0; --length) {
+                blob += alphabet[rng() % 5];
+            }
+            offsets.push_back(static_cast<std::uint32_t>(blob.size()));
+        }
+    }
+};
+
+// Run `scan` at every level and compare each result with the scalar one
+template <typename Scan>
+static void checkAgainstScalar(std::size_t n, Scan scan) {
+    PredicateKernels::setLevel(SimdLevel::SCALAR);
+    SelectionBitmap reference(n);
+    scan(reference.data());
+    for (SimdLevel level : LEVELS) {
+        PredicateKernels::setLevel(level);
+        if (PredicateKernels::level() != level) {
+            continue;  // Not supported here
+        }
+        SelectionBitmap result(n, true);  // Kernels must overwrite, not OR into, the output
+        scan(result.data());
+        for (std::size_t row = 0; row < n; ++row) {
+            if (result.test(row) != reference.test(row)) {
+                std::cerr << PredicateKernels::levelName(level) << ": row " << row << " of " << n << " differs\n";
+                CHECK(result.test(row) == reference.test(row));
+                break;
+            }
+        }
+        CHECK(result.count() == reference.count());
+    }
+}
+
+static void testKernelsMatchScalar() {
+    std::mt19937 rng(7);
+    // Sizes around the 16/32/64-row blocks and the tail handling
+    for (std::size_t n : {0, 1, 5, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 1000, 4099}) {
+        for (int round = 0; round < 10; ++round) {
+            Columns c(n, rng);
+            std::int32_t low32 = static_cast<std::int32_t>(rng() % 5) - 3;
+            std::int32_t high32 = low32 + static_cast<std::int32_t>(rng() % 3);
+            std::int64_t low64 = static_cast<std::int64_t>(rng() % 5) - 3;
+            std::int64_t high64 = low64 + 2;
+            std::uint32_t code = rng() % 4;
+
+            checkAgainstScalar(n, [&](std::uint64_t* out) { PredicateKernels::rangeInt32(c.int32s.data(), n, low32, high32, out); });
+            checkAgainstScalar(n, [&](std::uint64_t* out) { PredicateKernels::rangeInt64(c.int64s.data(), n, low64, high64, out); });
+            checkAgainstScalar(n, [&](std::uint64_t* out) { PredicateKernels::equalUInt32(c.codes.data(), n, code, out); });
+            checkAgainstScalar(n, [&](std::uint64_t* out) { PredicateKernels::nonZeroUInt8(c.flags.data(), n, out); });
+            for (std::string_view needle : {"", "a", "ab", "aba", "abab", "bab a", "zz"}) {
+                checkAgainstScalar(n, [&](std::uint64_t* out) {
+                    PredicateKernels::containsText(c.blob.data(), c.offsets.data(), n, needle, out);
+                });
+            }
+        }
+    }
+    PredicateKernels::setLevel(PredicateKernels::supportedLevel());
+}
+
+// The scalar level itself against plain comparisons, so the reference above is known good
+static void testScalarReference() {
+    std::mt19937 rng(11);
+    const std::size_t n = 300;
+    Columns c(n, rng);
+    PredicateKernels::setLevel(SimdLevel::SCALAR);
+    SelectionBitmap result(n);
+    PredicateKernels::rangeInt32(c.int32s.data(), n, -1, 1, result.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        CHECK(result.test(i) == (c.int32s[i] >= -1 && c.int32s[i] <= 1));
+    }
+    PredicateKernels::equalUInt32(c.codes.data(), n, 2, result.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        CHECK(result.test(i) == (c.codes[i] == 2));
+    }
+    PredicateKernels::containsText(c.blob.data(), c.offsets.data(), n, "ab", result.data());
+    for (std::size_t i = 0; i < n; ++i) {
+        std::string_view text = std::string_view(c.blob).substr(c.offsets[i], c.offsets[i + 1] - c.offsets[i]);
+        CHECK(result.test(i) == (text.find("ab") != std::string_view::npos));
+    }
+    PredicateKernels::setLevel(PredicateKernels::supportedLevel());
+}
+
+static void testBitmapCombinators() {
+    SelectionBitmap a(130);
+    SelectionBitmap b(130);
+    a.set(3);
+    a.set(129);
+    b.set(64);
+    b.set(129);
+    CHECK((a & b).count() == 1);
+    CHECK((a | b).count() == 3);
+    CHECK((~a).count() == 128);  // Complement stays within size()
+    CHECK(SelectionBitmap(a).andNot(b).handles() == std::vector<AttributeHandle>{3});
+    CHECK(SelectionBitmap(70, true).count() == 70);
+    CHECK_THROWS(a &= SelectionBitmap(5), std::invalid_argument);
+}
+
+static void testSnapshotFilters() {
+    HighLevelFeaturesRepoAgent features;
+    for (int i = 0; i < 1000; ++i) {
+        features.create("F" + std::to_string(i), {{"feature", "feat " + std::to_string(i)},
+                                                  {"description", i % 7 == 0 ? "uses realtime sync" : "plain"},
+                                                  {"priority", std::to_string(1 + i % 3)}});
+    }
+    features.remove("F0");
+    features.remove("F7");
+    features.update("F21", {{"feature", "feat 21"}, {"description", "plain"}, {"priority", "1"}});
+
+    auto snapshot = features.columnarSnapshot();
+    SelectionBitmap match = snapshot->matchPriority(1, 1) & snapshot->matchDescription("realtime");
+    std::size_t expected = 0;
+    for (int i = 0; i < 1000; ++i) {
+        expected += i % 3 == 0 && i % 7 == 0 && i != 0 && i != 21;
+    }
+    CHECK(match.count() == expected);
+    match.forEach([&](AttributeHandle row) {
+        CHECK(snapshot->priorityAt(row) == 1);
+        CHECK(snapshot->descriptionAt(row) == "uses realtime sync");
+    });
+    CHECK(snapshot->live().count() == 998);
+    CHECK(snapshot->matchDescription("").count() == 998);  // Removed rows never match
+    CHECK(snapshot->matchPriority(0, 0).count() == 0);
+}
+
+int main() {
+    testScalarReference();
+    testKernelsMatchScalar();
+    testBitmapCombinators();
+    testSnapshotFilters();
+    return testResult("PredicateKernelsTest");
+}
@@ -0,0 +1,59 @@
+#ifndef __TESTSUPPORT_HPP__
+#define __TESTSUPPORT_HPP__
+
+
+#include <iostream>
+#include <string>
+#include <filesystem>
+
+
+
+
+// Minimal checks for the test executables. Unlike assert() they stay on in Release (NDEBUG) builds;
+// a failed CHECK is reported and the run goes on, so one executable reports every failure at once
+inline int& testFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                        \
+    do {                                                                                        \
+        if (!(condition)) {                                                                     \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: " #condition "\n";     \
+            ++testFailures();                                                                   \
+        }                                                                                       \
+    } while (0)
+
+// CHECK that `statement` throws `Exception`
+#define CHECK_THROWS(statement, Exception)                                                      \
+    do {                                                                                        \
+        bool thrown = false;                                                                    \
+        try {                                                                                   \
+            statement;                                                                          \
+        } catch (const Exception&) {                                                           \
+            thrown = true;                                                                      \
+        }                                                                                       \
+        CHECK(thrown && #statement " throws " #Exception);                                      \
+    } while (0)
+
+// Exit code for main(): 0 when every CHECK passed
+inline int testResult(const char* name) {
+    if (testFailures() != 0) {
+        std::cerr << name << ": " << testFailures() << " check(s) failed\n";
+        return 1;
+    }
+    std::cout << name << ": ok\n";
+    return 0;
+}
+
+// Path of a scratch file or directory in the working directory (ctest runs each test in the build
+// tree), removed first so a previous run never leaks into this one
+inline std::string scratchPath(const std::string& name) {
+    std::filesystem::remove_all(name);
+    return name;
+}
+
+
+
+
+#endif // __TESTSUPPORT_HPP__